@@ -33,6 +33,81 @@
 #include <string.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <float.h>
+
+#if defined(TENSOR_CONVERTER_ENABLE_THREADS)
+#include <pthread.h>
+#endif
+
+#if defined(TENSOR_CONVERTER_ENABLE_MMAP)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define TENSOR_ARCH_X86 1
+#include <immintrin.h>
+#else
+#define TENSOR_ARCH_X86 0
+#endif
+
+// SIMD kernel availability. With GCC/Clang on x86 every variant is compiled
+// through target attributes and picked at runtime from cpuid, otherwise only
+// the variants enabled by the compiler flags are built.
+#if TENSOR_ARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define TENSOR_RUNTIME_DISPATCH 1
+#define TENSOR_HAVE_SSE2 1
+#define TENSOR_HAVE_AVX2 1
+#define TENSOR_HAVE_AVX512 1
+#define TENSOR_TARGET_SSE2 __attribute__((target("sse2")))
+#define TENSOR_TARGET_AVX2 __attribute__((target("avx2")))
+#define TENSOR_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+#define TENSOR_HAVE_F16C 1
+#define TENSOR_TARGET_F16C __attribute__((target("avx2,f16c")))
+#include <cpuid.h>
+#else
+#define TENSOR_RUNTIME_DISPATCH 0
+#if TENSOR_ARCH_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define TENSOR_HAVE_SSE2 1
+#else
+#define TENSOR_HAVE_SSE2 0
+#endif
+#if TENSOR_ARCH_X86 && defined(__AVX2__)
+#define TENSOR_HAVE_AVX2 1
+#else
+#define TENSOR_HAVE_AVX2 0
+#endif
+#if TENSOR_ARCH_X86 && defined(__AVX512F__) && defined(__AVX512BW__)
+#define TENSOR_HAVE_AVX512 1
+#else
+#define TENSOR_HAVE_AVX512 0
+#endif
+#if TENSOR_HAVE_AVX2 && defined(__F16C__)
+#define TENSOR_HAVE_F16C 1
+#else
+#define TENSOR_HAVE_F16C 0
+#endif
+#define TENSOR_TARGET_SSE2
+#define TENSOR_TARGET_AVX2
+#define TENSOR_TARGET_AVX512
+#define TENSOR_TARGET_F16C
+#endif
+
+// Register transposes rely on their loops being fully unrolled with constant
+// row indices, otherwise the row registers are kept in memory
+#if defined(__GNUC__) || defined(__clang__)
+#define TENSOR_FORCE_INLINE inline __attribute__((always_inline))
+#define TENSOR_UNROLL _Pragma("GCC unroll 64")
+#elif defined(_MSC_VER)
+#define TENSOR_FORCE_INLINE __forceinline
+#define TENSOR_UNROLL
+#else
+#define TENSOR_FORCE_INLINE inline
+#define TENSOR_UNROLL
+#endif
 
 // Error message macro definitions
 #define ERROR_MSG_SIZE 256
@@ -44,6 +119,31 @@
 #define ERROR_MSG_LAYOUT_CONVERSION "Layout conversion failed"
 #define ERROR_MSG_DATA_COPY "Data copy failed"
 #define ERROR_MSG_INVALID_LAYOUT "Invalid layout format"
+#define ERROR_MSG_BUFFER_TOO_SMALL "Destination buffer too small"
+#define ERROR_MSG_INVALID_QUANT "Invalid quantization parameters"
+#define ERROR_MSG_STREAM_ABORTED "Conversion aborted by stream callback"
+#define ERROR_MSG_FILE_IO "File I/O failed"
+#define ERROR_MSG_INVALID_PROTO "Invalid ONNX TensorProto"
+#define ERROR_MSG_INVALID_TFLITE "Invalid TFLite model"
+
+// Maximum number of tensor dimensions
+#define TENSOR_MAX_DIMS 8
+
+// Conversion flags (_ex variants)
+#define TENSOR_CONVERT_BORROW 0x1u  // Reference the source instead of copying when no permutation is needed
+
+// Tile edge (in elements) used by the cache-blocked layout kernels.
+// Two 32x32 tiles of 8-byte elements (source + destination) take 16 KB,
+// which keeps both streams resident in a typical 32 KB L1 data cache.
+#ifndef TENSOR_CONVERTER_TILE_SIZE
+#define TENSOR_CONVERTER_TILE_SIZE 32
+#endif
+
+// Minimum bytes per thread before a conversion is split across the worker
+// pool. Smaller tensors stay on the calling thread.
+#ifndef TENSOR_CONVERTER_PARALLEL_GRAIN
+#define TENSOR_CONVERTER_PARALLEL_GRAIN (256 * 1024)
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,7 +169,10 @@ typedef enum {
     LAYOUT_UNKNOWN = 0,
     LAYOUT_NCHW = 1,    // ONNX common format (Batch, Channel, Height, Width)
     LAYOUT_NHWC = 2,    // TFLite common format (Batch, Height, Width, Channel)
-    LAYOUT_GENERIC = 3  // Other dimension layouts, no conversion needed
+    LAYOUT_GENERIC = 3, // Other dimension layouts, no conversion needed
+    LAYOUT_OIHW = 4,    // ONNX Conv weights (Out channels, In channels, Height, Width)
+    LAYOUT_OHWI = 5,    // TFLite Conv weights (Out channels, Height, Width, In channels)
+    LAYOUT_HWIO = 6     // TensorFlow Conv weights (Height, Width, In channels, Out channels)
 } tensor_layout_t;
 
 /**
@@ -91,6 +194,7 @@ typedef struct {
     size_t data_size;        // Data size (bytes)
     tensor_shape_t shape;       // Tensor shape information
     bool success;            // Whether conversion was successful
+    bool borrowed;           // data and shape.dims are caller memory, not freed
     char error_msg[ERROR_MSG_SIZE];     // Error message
 } conversion_result_t;
 
@@ -265,448 +369,6345 @@ static inline tensor_layout_t detect_tensor_layout(const int32_t* dims, size_t n
 }
 
 /**
- * NCHW to NHWC layout conversion
- * @param src Source data pointer
- * @param dst Destination data pointer
- * @param N Batch size
- * @param C Number of channels
- * @param H Height
- * @param W Width
- * @param element_size Single element byte size
- * @return Whether conversion was successful
+ * Transpose block kernel: dst[c][r] = src[r][c] for a block that fits in a tile
+ * @param src Source block pointer
+ * @param src_stride Distance between consecutive source rows (elements)
+ * @param dst Destination block pointer
+ * @param dst_stride Distance between consecutive destination rows (elements)
+ * @param rows Number of source rows in the block
+ * @param cols Number of source columns in the block
  */
-static inline bool convert_nchw_to_nhwc(const void* src, void* dst,
-                         int32_t N, int32_t C, int32_t H, int32_t W,
-                         size_t element_size) {
-    if (!src || !dst || N <= 0 || C <= 0 || H <= 0 || W <= 0 || element_size == 0) {
-        return false;
-    }
+typedef void (*transpose_block_fn)(const void* src, size_t src_stride,
+                                   void* dst, size_t dst_stride,
+                                   size_t rows, size_t cols);
 
-    // Check for potential overflow in index calculations
-    if ((size_t)N > SIZE_MAX / (size_t)C / (size_t)H / (size_t)W ||
-        (size_t)C > SIZE_MAX / (size_t)H / (size_t)W ||
-        (size_t)H > SIZE_MAX / (size_t)W) {
-        return false; // Overflow would occur
+// Element-size-specialized block kernels. The element type is fixed at
+// compile time so the inner loop is a plain load/store that the compiler
+// can unroll and vectorize. Elements move through fixed-size memcpy, which
+// compiles to a single unaligned move and keeps misaligned buffers defined.
+// The write side is sequential, reads revisit the same tile rows while they
+// are still in L1.
+#define TENSOR_DEFINE_TRANSPOSE_BLOCK(suffix, type)                              \
+    static inline void transpose_block_##suffix(const void* src, size_t src_stride, \
+                                                void* dst, size_t dst_stride,    \
+                                                size_t rows, size_t cols) {      \
+        const char* src_data = (const char*)src;                                 \
+        char* dst_data = (char*)dst;                                             \
+        for (size_t c = 0; c < cols; c++) {                                      \
+            const char* src_ptr = src_data + c * sizeof(type);                   \
+            char* dst_ptr = dst_data + c * dst_stride * sizeof(type);            \
+            for (size_t r = 0; r < rows; r++) {                                  \
+                type value;                                                      \
+                memcpy(&value, src_ptr + r * src_stride * sizeof(type), sizeof(type)); \
+                memcpy(dst_ptr + r * sizeof(type), &value, sizeof(type));        \
+            }                                                                    \
+        }                                                                        \
     }
 
-    // Additional check: ensure total elements calculation doesn't overflow
-    size_t total_elements = (size_t)N * C * H * W;
-    if (total_elements == 0 || total_elements > SIZE_MAX / element_size) {
-        return false;
+TENSOR_DEFINE_TRANSPOSE_BLOCK(8, uint8_t)
+TENSOR_DEFINE_TRANSPOSE_BLOCK(16, uint16_t)
+TENSOR_DEFINE_TRANSPOSE_BLOCK(32, uint32_t)
+TENSOR_DEFINE_TRANSPOSE_BLOCK(64, uint64_t)
+
+#undef TENSOR_DEFINE_TRANSPOSE_BLOCK
+
+#if TENSOR_HAVE_SSE2
+// SSE2 block kernels: a square of 16-byte rows (16x16 bytes, 8x8 2-byte,
+// 4x4 4-byte) is transposed by log2(rows) rounds of unpacking row i with
+// row i + rows/2 at element granularity. Leftover rows and columns use the
+// scalar typed kernel. 8-byte elements keep the scalar kernel, a 2x2
+// register transpose does not beat it.
+#define TENSOR_DEFINE_TRANSPOSE_BLOCK_SSE2(suffix, type, unpacklo, unpackhi)                 \
+    static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE void transpose_square_##suffix##_sse2(      \
+        const type* src, size_t src_stride, type* dst, size_t dst_stride) {                  \
+        enum { num_rows = 16 / sizeof(type) };                                                \
+        __m128i v[num_rows];                                                                  \
+        __m128i t[num_rows];                                                                  \
+        TENSOR_UNROLL                                                                         \
+        for (size_t i = 0; i < num_rows; i++) {                                               \
+            v[i] = _mm_loadu_si128((const __m128i*)(const void*)(src + i * src_stride));      \
+        }                                                                                     \
+        TENSOR_UNROLL                                                                         \
+        for (size_t round = 1; round < num_rows; round *= 2) {                                \
+            TENSOR_UNROLL                                                                     \
+            for (size_t i = 0; i < num_rows / 2; i++) {                                       \
+                t[2 * i] = unpacklo(v[i], v[i + num_rows / 2]);                               \
+                t[2 * i + 1] = unpackhi(v[i], v[i + num_rows / 2]);                           \
+            }                                                                                 \
+            TENSOR_UNROLL                                                                     \
+            for (size_t i = 0; i < num_rows; i++) {                                           \
+                v[i] = t[i];                                                                  \
+            }                                                                                 \
+        }                                                                                     \
+        TENSOR_UNROLL                                                                         \
+        for (size_t i = 0; i < num_rows; i++) {                                               \
+            _mm_storeu_si128((__m128i*)(void*)(dst + i * dst_stride), v[i]);                  \
+        }                                                                                     \
+    }                                                                                         \
+    static TENSOR_TARGET_SSE2 void transpose_block_##suffix##_sse2(                          \
+        const void* src, size_t src_stride, void* dst, size_t dst_stride,                    \
+        size_t rows, size_t cols) {                                                           \
+        const type* src_data = (const type*)src;                                             \
+        type* dst_data = (type*)dst;                                                         \
+        const size_t edge = 16 / sizeof(type);                                               \
+        size_t full_rows = rows - rows % edge;                                               \
+        size_t full_cols = cols - cols % edge;                                               \
+        for (size_t r = 0; r < full_rows; r += edge) {                                       \
+            for (size_t c = 0; c < full_cols; c += edge) {                                   \
+                transpose_square_##suffix##_sse2(src_data + r * src_stride + c, src_stride,  \
+                                                 dst_data + c * dst_stride + r, dst_stride); \
+            }                                                                                 \
+        }                                                                                     \
+        if (full_rows < rows) {                                                               \
+            transpose_block_##suffix(src_data + full_rows * src_stride, src_stride,          \
+                                     dst_data + full_rows, dst_stride,                       \
+                                     rows - full_rows, full_cols);                            \
+        }                                                                                     \
+        if (full_cols < cols) {                                                               \
+            transpose_block_##suffix(src_data + full_cols, src_stride,                       \
+                                     dst_data + full_cols * dst_stride, dst_stride,          \
+                                     rows, cols - full_cols);                                 \
+        }                                                                                     \
     }
 
-    // Validate memory boundaries
-    if (!validate_memory_boundaries(src, dst, total_elements, element_size)) {
-        return false;
+TENSOR_DEFINE_TRANSPOSE_BLOCK_SSE2(8, uint8_t, _mm_unpacklo_epi8, _mm_unpackhi_epi8)
+TENSOR_DEFINE_TRANSPOSE_BLOCK_SSE2(16, uint16_t, _mm_unpacklo_epi16, _mm_unpackhi_epi16)
+TENSOR_DEFINE_TRANSPOSE_BLOCK_SSE2(32, uint32_t, _mm_unpacklo_epi32, _mm_unpackhi_epi32)
+
+#undef TENSOR_DEFINE_TRANSPOSE_BLOCK_SSE2
+#endif // TENSOR_HAVE_SSE2
+
+#if TENSOR_HAVE_AVX2
+/**
+ * AVX2 8x8 transpose of 4-byte elements held in registers
+ * Rows are transposed with unpack/shuffle/permute; on return r[i] holds
+ * column i.
+ */
+static TENSOR_TARGET_AVX2 TENSOR_FORCE_INLINE void transpose_8x8_ps_avx2(__m256* r) {
+    // Interleave row pairs: 2x2 blocks within each 128-bit lane
+    __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+    __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+    __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+    __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+    __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+    // Combine pairs: 4x4 blocks within each 128-bit lane
+    __m256 u0 = _mm256_shuffle_ps(t0, t2, 0x44);
+    __m256 u1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+    __m256 u2 = _mm256_shuffle_ps(t1, t3, 0x44);
+    __m256 u3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+    __m256 u4 = _mm256_shuffle_ps(t4, t6, 0x44);
+    __m256 u5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+    __m256 u6 = _mm256_shuffle_ps(t5, t7, 0x44);
+    __m256 u7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+    // Swap 128-bit lanes across the two halves
+    r[0] = _mm256_permute2f128_ps(u0, u4, 0x20);
+    r[1] = _mm256_permute2f128_ps(u1, u5, 0x20);
+    r[2] = _mm256_permute2f128_ps(u2, u6, 0x20);
+    r[3] = _mm256_permute2f128_ps(u3, u7, 0x20);
+    r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+/**
+ * AVX2 8x8 register transpose of 4-byte elements
+ * Loads 8 source rows of 8 elements, transposes them in registers and
+ * stores 8 contiguous destination rows.
+ */
+static TENSOR_TARGET_AVX2 TENSOR_FORCE_INLINE void transpose_8x8_32_avx2(const uint32_t* src, size_t src_stride,
+                                         uint32_t* dst, size_t dst_stride) {
+    __m256 r[8];
+    TENSOR_UNROLL
+    for (size_t i = 0; i < 8; i++) {
+        r[i] = _mm256_loadu_ps((const float*)(src + i * src_stride));
+    }
+    transpose_8x8_ps_avx2(r);
+    TENSOR_UNROLL
+    for (size_t i = 0; i < 8; i++) {
+        _mm256_storeu_ps((float*)(dst + i * dst_stride), r[i]);
     }
+}
 
-    const char* src_data = (const char*)src;
-    char* dst_data = (char*)dst;
+/**
+ * AVX2 block kernel for 4-byte elements (TENSOR_FLOAT32, TENSOR_INT32)
+ * Full 8x8 sub-blocks go through the register transpose, the remaining
+ * rows and columns take the scalar edge path.
+ */
+static TENSOR_TARGET_AVX2 void transpose_block_32_avx2(const void* src, size_t src_stride,
+                                           void* dst, size_t dst_stride,
+                                           size_t rows, size_t cols) {
+    const uint32_t* src_data = (const uint32_t*)src;
+    uint32_t* dst_data = (uint32_t*)dst;
+    size_t full_rows = rows & ~(size_t)7;
+    size_t full_cols = cols & ~(size_t)7;
 
-    // NCHW: [N][C][H][W] -> NHWC: [N][H][W][C]
-    for (int32_t n = 0; n < N; n++) {
-        for (int32_t h = 0; h < H; h++) {
-            for (int32_t w = 0; w < W; w++) {
-                for (int32_t c = 0; c < C; c++) {
-                    // NCHW index: n*C*H*W + c*H*W + h*W + w
-                    size_t src_idx = (size_t)n * C * H * W + (size_t)c * H * W + (size_t)h * W + (size_t)w;
-                    // NHWC index: n*H*W*C + h*W*C + w*C + c
-                    size_t dst_idx = (size_t)n * H * W * C + (size_t)h * W * C + (size_t)w * C + (size_t)c;
-
-                    // Final safety check: ensure indices are within bounds
-                    if (src_idx >= total_elements || dst_idx >= total_elements) {
-                        return false;
-                    }
-
-                    memcpy(dst_data + dst_idx * element_size,
-                           src_data + src_idx * element_size,
-                           element_size);
-                }
-            }
+    for (size_t c = 0; c < full_cols; c += 8) {
+        for (size_t r = 0; r < full_rows; r += 8) {
+            transpose_8x8_32_avx2(src_data + r * src_stride + c, src_stride,
+                                  dst_data + c * dst_stride + r, dst_stride);
         }
     }
-    return true;
+    // Scalar edge: leftover rows of the full column blocks
+    if (full_rows < rows) {
+        transpose_block_32(src_data + full_rows * src_stride, src_stride,
+                           dst_data + full_rows, dst_stride,
+                           rows - full_rows, full_cols);
+    }
+    // Scalar edge: leftover columns across all rows
+    if (full_cols < cols) {
+        transpose_block_32(src_data + full_cols, src_stride,
+                           dst_data + full_cols * dst_stride, dst_stride,
+                           rows, cols - full_cols);
+    }
 }
+#endif // TENSOR_HAVE_AVX2
 
+#if TENSOR_HAVE_AVX512
 /**
- * NHWC to NCHW layout conversion
- * @param src Source data pointer
- * @param dst Destination data pointer
- * @param N Batch size
- * @param H Height
- * @param W Width
- * @param C Number of channels
+ * One butterfly stage of the AVX-512 square transpose
+ * Rows i and i+k (k = shift_bytes / element size, i & k == 0) exchange their
+ * off-diagonal k x k element blocks. Running the stage for every power of two
+ * from 32 bytes down to the element size leaves the square transposed.
+ * @param v Row registers, one 64-byte row each
+ * @param num_rows Number of rows (64 / element size)
+ * @param shift_bytes Block width of this stage in bytes
  * @param element_size Single element byte size
- * @return Whether conversion was successful
  */
-static inline bool convert_nhwc_to_nchw(const void* src, void* dst,
-                         int32_t N, int32_t H, int32_t W, int32_t C,
-                         size_t element_size) {
-    if (!src || !dst || N <= 0 || H <= 0 || W <= 0 || C <= 0 || element_size == 0) {
-        return false;
+static TENSOR_TARGET_AVX512 TENSOR_FORCE_INLINE void transpose_stage_avx512(__m512i* v, size_t num_rows,
+                                          size_t shift_bytes, size_t element_size) {
+    size_t k = shift_bytes / element_size;
+    TENSOR_UNROLL
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i & k) {
+            continue;
+        }
+        __m512i a = v[i];
+        __m512i c = v[i + k];
+        switch (shift_bytes) {
+            case 32:
+                v[i] = _mm512_shuffle_i64x2(a, c, 0x44);
+                v[i + k] = _mm512_shuffle_i64x2(a, c, 0xEE);
+                break;
+            case 16:
+                v[i] = _mm512_permutex2var_epi64(a, _mm512_set_epi64(13, 12, 5, 4, 9, 8, 1, 0), c);
+                v[i + k] = _mm512_permutex2var_epi64(a, _mm512_set_epi64(15, 14, 7, 6, 11, 10, 3, 2), c);
+                break;
+            case 8:
+                v[i] = _mm512_mask_blend_epi64(0xAA, a, _mm512_bslli_epi128(c, 8));
+                v[i + k] = _mm512_mask_blend_epi64(0xAA, _mm512_bsrli_epi128(a, 8), c);
+                break;
+            case 4:
+                v[i] = _mm512_mask_blend_epi32(0xAAAA, a, _mm512_slli_epi64(c, 32));
+                v[i + k] = _mm512_mask_blend_epi32(0xAAAA, _mm512_srli_epi64(a, 32), c);
+                break;
+            case 2:
+                v[i] = _mm512_mask_blend_epi16(0xAAAAAAAAu, a, _mm512_slli_epi32(c, 16));
+                v[i + k] = _mm512_mask_blend_epi16(0xAAAAAAAAu, _mm512_srli_epi32(a, 16), c);
+                break;
+            default:
+                v[i] = _mm512_mask_blend_epi8(0xAAAAAAAAAAAAAAAAull, a, _mm512_slli_epi16(c, 8));
+                v[i + k] = _mm512_mask_blend_epi8(0xAAAAAAAAAAAAAAAAull, _mm512_srli_epi16(a, 8), c);
+                break;
+        }
     }
+}
 
-    // Check for potential overflow in index calculations
-    if ((size_t)N > SIZE_MAX / (size_t)H / (size_t)W / (size_t)C ||
-        (size_t)H > SIZE_MAX / (size_t)W / (size_t)C ||
-        (size_t)W > SIZE_MAX / (size_t)C) {
-        return false; // Overflow would occur
+/**
+ * AVX-512 register transpose of a square of 64-byte rows
+ * 8x8 for 8-byte, 16x16 for 4-byte, 32x32 for 2-byte and 64x64 for 1-byte
+ * elements. Strides are in bytes.
+ */
+static TENSOR_TARGET_AVX512 TENSOR_FORCE_INLINE void transpose_square_avx512(const char* src, size_t src_stride,
+                                           char* dst, size_t dst_stride,
+                                           size_t element_size) {
+    __m512i v[64];
+    size_t num_rows = 64 / element_size;
+    TENSOR_UNROLL
+    for (size_t i = 0; i < num_rows; i++) {
+        v[i] = _mm512_loadu_si512((const void*)(src + i * src_stride));
     }
-    // Additional check: ensure total elements calculation doesn't overflow
-    size_t total_elements = (size_t)N * H * W * C;
-    if (total_elements == 0 || total_elements > SIZE_MAX / element_size) {
-        return false;
+    TENSOR_UNROLL
+    for (size_t shift_bytes = 32; shift_bytes >= element_size; shift_bytes /= 2) {
+        transpose_stage_avx512(v, num_rows, shift_bytes, element_size);
     }
-    // Validate memory boundaries
-    if (!validate_memory_boundaries(src, dst, total_elements, element_size)) {
-        return false;
+    TENSOR_UNROLL
+    for (size_t i = 0; i < num_rows; i++) {
+        _mm512_storeu_si512((void*)(dst + i * dst_stride), v[i]);
     }
+}
 
-    const char* src_data = (const char*)src;
-    char* dst_data = (char*)dst;
+// AVX-512 block kernels: full squares go through the register transpose,
+// leftover rows and columns use the given edge kernel.
+#define TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512(suffix, type, edge_kernel)                 \
+    static TENSOR_TARGET_AVX512 void transpose_block_##suffix##_avx512(const void* src, size_t src_stride, \
+                                                         void* dst, size_t dst_stride,  \
+                                                         size_t rows, size_t cols) {    \
+        const type* src_data = (const type*)src;                                        \
+        type* dst_data = (type*)dst;                                                    \
+        const size_t edge = 64 / sizeof(type);                                          \
+        size_t full_rows = rows - rows % edge;                                          \
+        size_t full_cols = cols - cols % edge;                                          \
+        for (size_t r = 0; r < full_rows; r += edge) {                                  \
+            for (size_t c = 0; c < full_cols; c += edge) {                              \
+                transpose_square_avx512((const char*)(src_data + r * src_stride + c),   \
+                                        src_stride * sizeof(type),                      \
+                                        (char*)(dst_data + c * dst_stride + r),         \
+                                        dst_stride * sizeof(type), sizeof(type));       \
+            }                                                                           \
+        }                                                                               \
+        if (full_rows < rows) {                                                         \
+            edge_kernel(src_data + full_rows * src_stride, src_stride,                  \
+                        dst_data + full_rows, dst_stride, rows - full_rows, full_cols); \
+        }                                                                               \
+        if (full_cols < cols) {                                                         \
+            edge_kernel(src_data + full_cols, src_stride,                               \
+                        dst_data + full_cols * dst_stride, dst_stride,                  \
+                        rows, cols - full_cols);                                        \
+        }                                                                               \
+    }
 
-    // NHWC: [N][H][W][C] -> NCHW: [N][C][H][W]
-    for (int32_t n = 0; n < N; n++) {
-        for (int32_t c = 0; c < C; c++) {
-            for (int32_t h = 0; h < H; h++) {
-                for (int32_t w = 0; w < W; w++) {
-                    // NHWC index: n*H*W*C + h*W*C + w*C + c
-                    size_t src_idx = (size_t)n * H * W * C + (size_t)h * W * C + (size_t)w * C + (size_t)c;
-                    // NCHW index: n*C*H*W + c*H*W + h*W + w
-                    size_t dst_idx = (size_t)n * C * H * W + (size_t)c * H * W + (size_t)h * W + (size_t)w;
-
-                    // Final safety check: ensure indices are within bounds
-                    if (src_idx >= total_elements || dst_idx >= total_elements) {
-                        return false;
-                    }
-
-                    memcpy(dst_data + dst_idx * element_size,
-                           src_data + src_idx * element_size,
-                           element_size);
-                }
-            }
-        }
+TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512(8, uint8_t, transpose_block_8)
+TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512(16, uint16_t, transpose_block_16)
+TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512(32, uint32_t, transpose_block_32_avx2)
+TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512(64, uint64_t, transpose_block_64)
+
+#undef TENSOR_DEFINE_TRANSPOSE_BLOCK_AVX512
+#endif // TENSOR_HAVE_AVX512
+
+/**
+ * Convert float32 to float16 bits, rounding to nearest even
+ * Overflow gives infinity, NaNs stay quiet NaNs with the top payload bits
+ * (the same results as vcvtps2ph).
+ * @param value Float32 value
+ * @return Float16 bit pattern
+ */
+static inline uint16_t float32_to_float16(float value) {
+    uint32_t x;
+    memcpy(&x, &value, sizeof(x));
+    uint32_t sign = x & 0x80000000u;
+    uint16_t half;
+    x ^= sign;
+
+    if (x >= 0x47800000u) {
+        // Out of float16 range, infinity or NaN
+        half = (uint16_t)(x > 0x7f800000u ? 0x7e00u | ((x >> 13) & 0x3ffu) : 0x7c00u);
+    } else if (x < 0x38800000u) {
+        // Float16 subnormal or zero: adding 0.5f aligns the mantissa and rounds
+        float aligned;
+        uint32_t bits;
+        memcpy(&aligned, &x, sizeof(aligned));
+        aligned += 0.5f;
+        memcpy(&bits, &aligned, sizeof(bits));
+        half = (uint16_t)(bits - 0x3f000000u);
+    } else {
+        // Normal: rebias the exponent and round the dropped 13 bits to even
+        uint32_t mant_odd = (x >> 13) & 1u;
+        x += 0xc8000fffu + mant_odd;
+        half = (uint16_t)(x >> 13);
     }
-    return true;
+    return (uint16_t)(half | (sign >> 16));
 }
 
 /**
- * ONNX to TFLite conversion with layout conversion
- * @param onnx_data ONNX tensor data pointer
- * @param dims Tensor dimension array
- * @param num_dims Number of dimensions
- * @param data_type Data type
- * @param src_layout Source layout format
- * @param dst_layout Destination layout format
- * @return conversion_result_t Conversion result
+ * Convert float16 bits to float32 (exact)
+ * @param value Float16 bit pattern
+ * @return Float32 value
  */
-static inline conversion_result_t onnx_to_tflite_with_layout(const void* onnx_data,
-                                                          const int32_t* dims,
-                                                          size_t num_dims,
-                                                          tensor_data_type_t data_type,
-                                                          tensor_layout_t src_layout,
-                                                          tensor_layout_t dst_layout) {
-    conversion_result_t result = {0};
+static inline float float16_to_float32(uint16_t value) {
+    uint32_t bits = (uint32_t)(value & 0x7fffu) << 13;
+    uint32_t exponent = bits & 0x0f800000u;
+    float result;
+    bits += 0x38000000u; // Rebias the exponent
 
-    // Validate input parameters
-    if (!onnx_data || !dims || num_dims == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_NULL_POINTER);
-        return result;
+    if (exponent == 0x0f800000u) {
+        // Infinity or NaN (NaNs are quieted)
+        bits += 0x38000000u;
+        if (bits & 0x007fffffu) {
+            bits |= 0x00400000u;
+        }
+    } else if (exponent == 0) {
+        // Zero or subnormal: renormalize through a float subtraction
+        const uint32_t magic_bits = 0x38800000u;
+        float magic;
+        bits += 0x00800000u;
+        memcpy(&result, &bits, sizeof(result));
+        memcpy(&magic, &magic_bits, sizeof(magic));
+        result -= magic;
+        memcpy(&bits, &result, sizeof(bits));
     }
+    bits |= (uint32_t)(value & 0x8000u) << 16;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
 
-    if (!validate_tensor_shape(dims, num_dims)) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS);
-        return result;
+/**
+ * Row conversion kernel: converts count contiguous elements
+ * @param src Source elements
+ * @param dst Destination elements
+ * @param count Number of elements
+ */
+typedef void (*convert_row_fn)(const void* src, void* dst, size_t count);
+
+static inline void convert_row_f32_to_f16(const void* src, void* dst, size_t count) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    for (size_t i = 0; i < count; i++) {
+        dst_data[i] = float32_to_float16(src_data[i]);
     }
+}
 
-    size_t element_size = get_data_type_size(data_type);
-    if (element_size == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_UNSUPPORTED_TYPE ": %d", data_type);
-        return result;
+static inline void convert_row_f16_to_f32(const void* src, void* dst, size_t count) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    for (size_t i = 0; i < count; i++) {
+        dst_data[i] = float16_to_float32(src_data[i]);
     }
+}
 
-    size_t total_elements = calculate_total_elements(dims, num_dims);
-    if (total_elements == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS);
-        return result;
+// Fused transpose + conversion block kernels. Strides are in elements of
+// the respective source and destination types.
+static inline void transpose_block_f32_to_f16(const void* src, size_t src_stride,
+                                              void* dst, size_t dst_stride,
+                                              size_t rows, size_t cols) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    for (size_t c = 0; c < cols; c++) {
+        const float* src_ptr = src_data + c;
+        uint16_t* dst_ptr = dst_data + c * dst_stride;
+        for (size_t r = 0; r < rows; r++) {
+            dst_ptr[r] = float32_to_float16(src_ptr[r * src_stride]);
+        }
     }
+}
 
-    // Check for overflow in total_bytes calculation
-    if (total_elements > SIZE_MAX / element_size) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS ": size too large");
-        return result;
+static inline void transpose_block_f16_to_f32(const void* src, size_t src_stride,
+                                              void* dst, size_t dst_stride,
+                                              size_t rows, size_t cols) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    for (size_t c = 0; c < cols; c++) {
+        const uint16_t* src_ptr = src_data + c;
+        float* dst_ptr = dst_data + c * dst_stride;
+        for (size_t r = 0; r < rows; r++) {
+            dst_ptr[r] = float16_to_float32(src_ptr[r * src_stride]);
+        }
     }
+}
 
-    size_t total_bytes = element_size * total_elements;
+#if TENSOR_HAVE_SSE2
+/**
+ * SSE2 float32 to float16 conversion of 4 lanes (software, round to nearest even)
+ * Branch-free form of float32_to_float16.
+ * @return 4 float16 values in the low 64 bits
+ */
+static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE __m128i float32_to_float16_sse2(__m128 value) {
+    __m128i x = _mm_castps_si128(value);
+    __m128i sign = _mm_and_si128(x, _mm_set1_epi32((int)0x80000000u));
+    x = _mm_xor_si128(x, sign);
 
-    // Allocate memory for TFLite format data
-    result.data = malloc(total_bytes);
-    if (!result.data) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_MEMORY_ALLOC ": %zu bytes", total_bytes);
-        return result;
-    }
+    __m128i mant_odd = _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(1));
+    __m128i normal = _mm_srli_epi32(
+        _mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32((int)0xc8000fffu)), mant_odd), 13);
 
-    // Allocate and copy dimension information
-    result.shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
-    if (!result.shape.dims) {
-        free(result.data);
-        result.data = NULL;
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_MEMORY_ALLOC);
-        return result;
-    }
+    __m128 aligned = _mm_add_ps(_mm_castsi128_ps(x), _mm_set1_ps(0.5f));
+    __m128i subnormal = _mm_sub_epi32(_mm_castps_si128(aligned), _mm_set1_epi32(0x3f000000));
 
-    // Set result information
-    result.shape.num_dims = num_dims;
-    result.shape.data_type = data_type;
-    result.shape.total_elements = total_elements;
-    result.shape.layout = dst_layout;
-    result.data_size = total_bytes;
+    __m128i is_nan = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x7f800000));
+    __m128i nan = _mm_or_si128(_mm_set1_epi32(0x7e00),
+                               _mm_and_si128(_mm_srli_epi32(x, 13), _mm_set1_epi32(0x3ff)));
+    __m128i special = _mm_or_si128(_mm_and_si128(is_nan, nan),
+                                   _mm_andnot_si128(is_nan, _mm_set1_epi32(0x7c00)));
 
-    // Check if layout conversion is needed
-    bool need_layout_conversion = false;
-    if (num_dims == 4 && src_layout != dst_layout) {
-        // Only conversion between NCHW and NHWC is supported
-        if ((src_layout == LAYOUT_NCHW && dst_layout == LAYOUT_NHWC) ||
-            (src_layout == LAYOUT_NHWC && dst_layout == LAYOUT_NCHW)) {
-            need_layout_conversion = true;
-        } else if (src_layout != LAYOUT_UNKNOWN && dst_layout != LAYOUT_UNKNOWN) {
-            // Any other explicit layout conversion is not supported
-            free(result.data);
-            free(result.shape.dims);
-            result.data = NULL;
-            result.shape.dims = NULL;
-            safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                    ERROR_MSG_LAYOUT_CONVERSION ": from %d to %d", src_layout, dst_layout);
-            return result;
-        }
-    }
+    __m128i is_special = _mm_cmpgt_epi32(x, _mm_set1_epi32(0x477fffff));
+    __m128i is_subnormal = _mm_cmplt_epi32(x, _mm_set1_epi32(0x38800000));
+    __m128i half = _mm_or_si128(_mm_and_si128(is_subnormal, subnormal),
+                                _mm_andnot_si128(is_subnormal, normal));
+    half = _mm_or_si128(_mm_and_si128(is_special, special), _mm_andnot_si128(is_special, half));
+    half = _mm_or_si128(half, _mm_srli_epi32(sign, 16));
 
-    if (need_layout_conversion) {
-        // Layout conversion needed
-        if (src_layout == LAYOUT_NCHW && dst_layout == LAYOUT_NHWC) {
-            // NCHW -> NHWC
-            memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-            // Convert dimension order: [N,C,H,W] -> [N,H,W,C]
-            // Keep N at index 0, move H to index 1, W to index 2, C to index 3
-            result.shape.dims[1] = dims[2]; // H (was at index 2)
-            result.shape.dims[2] = dims[3]; // W (was at index 3)
-            result.shape.dims[3] = dims[1]; // C (was at index 1)
-
-            if (!convert_nchw_to_nhwc(onnx_data, result.data,
-                                     dims[0], dims[1], dims[2], dims[3],
-                                     element_size)) {
-                free(result.data);
-                free(result.shape.dims);
-                result.data = NULL;
-                result.shape.dims = NULL;
-                safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                        ERROR_MSG_LAYOUT_CONVERSION);
-                return result;
-            }
-        } else if (src_layout == LAYOUT_NHWC && dst_layout == LAYOUT_NCHW) {
-            // NHWC -> NCHW
-            memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-            // Convert dimension order: [N,H,W,C] -> [N,C,H,W]
-            // Keep N at index 0, move C to index 1, H to index 2, W to index 3
-            result.shape.dims[1] = dims[3]; // C (was at index 3)
-            result.shape.dims[2] = dims[1]; // H (was at index 1)
-            result.shape.dims[3] = dims[2]; // W (was at index 2)
-
-            if (!convert_nhwc_to_nchw(onnx_data, result.data,
-                                     dims[0], dims[1], dims[2], dims[3],
-                                     element_size)) {
-                free(result.data);
-                free(result.shape.dims);
-                result.data = NULL;
-                result.shape.dims = NULL;
-                safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                        ERROR_MSG_LAYOUT_CONVERSION);
-                return result;
-            }
-        }
-    } else {
-        // No layout conversion needed, copy directly
-        memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-        if (!copy_tensor_data(onnx_data, result.data, element_size, total_elements)) {
-            free(result.data);
-            free(result.shape.dims);
-            result.data = NULL;
-            result.shape.dims = NULL;
-            safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                    ERROR_MSG_DATA_COPY);
-            return result;
-        }
-    }
-    result.success = true;
-    return result;
+    // Sign-extend so the signed saturating pack keeps all 16 bits
+    half = _mm_srai_epi32(_mm_slli_epi32(half, 16), 16);
+    return _mm_packs_epi32(half, half);
 }
 
 /**
- * TFLite to ONNX conversion with layout conversion
- * @param tflite_data TFLite tensor data pointer
- * @param dims Tensor dimension array
- * @param num_dims Number of dimensions
- * @param data_type Data type
- * @param src_layout Source layout format
- * @param dst_layout Destination layout format
- * @return conversion_result_t Conversion result
+ * SSE2 float16 to float32 conversion of 4 lanes (software, exact)
+ * Branch-free form of float16_to_float32.
+ * @param half 4 float16 values in the low 64 bits
  */
-static inline conversion_result_t tflite_to_onnx_with_layout(const void* tflite_data,
-                                                          const int32_t* dims,
-                                                          size_t num_dims,
-                                                          tensor_data_type_t data_type,
-                                                          tensor_layout_t src_layout,
-                                                          tensor_layout_t dst_layout) {
-    conversion_result_t result = {0};
+static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE __m128 float16_to_float32_sse2(__m128i half) {
+    __m128i h = _mm_unpacklo_epi16(half, _mm_setzero_si128());
+    __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+    __m128i bits = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+    __m128i exponent = _mm_and_si128(bits, _mm_set1_epi32(0x0f800000));
+    bits = _mm_add_epi32(bits, _mm_set1_epi32(0x38000000));
 
-    // Validate input parameters
-    if (!tflite_data || !dims || num_dims == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_NULL_POINTER);
-        return result;
-    }
+    __m128i is_special = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0f800000));
+    __m128i special = _mm_add_epi32(bits, _mm_set1_epi32(0x38000000));
+    __m128i is_nan = _mm_andnot_si128(
+        _mm_cmpeq_epi32(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_setzero_si128()),
+        is_special);
+    special = _mm_or_si128(special, _mm_and_si128(is_nan, _mm_set1_epi32(0x00400000)));
 
-    if (!validate_tensor_shape(dims, num_dims)) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS);
-        return result;
-    }
+    __m128i is_subnormal = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+    __m128 renormalized = _mm_sub_ps(
+        _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(0x00800000))),
+        _mm_castsi128_ps(_mm_set1_epi32(0x38800000)));
 
-    size_t element_size = get_data_type_size(data_type);
-    if (element_size == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_UNSUPPORTED_TYPE ": %d", data_type);
-        return result;
-    }
+    bits = _mm_or_si128(_mm_and_si128(is_special, special), _mm_andnot_si128(is_special, bits));
+    bits = _mm_or_si128(_mm_and_si128(is_subnormal, _mm_castps_si128(renormalized)),
+                        _mm_andnot_si128(is_subnormal, bits));
+    return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
 
-    size_t total_elements = calculate_total_elements(dims, num_dims);
-    if (total_elements == 0) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS);
-        return result;
+static TENSOR_TARGET_SSE2 void convert_row_f32_to_f16_sse2(const void* src, void* dst, size_t count) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storel_epi64((__m128i*)(void*)(dst_data + i),
+                         float32_to_float16_sse2(_mm_loadu_ps(src_data + i)));
     }
+    convert_row_f32_to_f16(src_data + i, dst_data + i, count - i);
+}
 
-    // Check for overflow in total_bytes calculation
-    if (total_elements > SIZE_MAX / element_size) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_INVALID_DIMS ": size too large");
-        return result;
+static TENSOR_TARGET_SSE2 void convert_row_f16_to_f32_sse2(const void* src, void* dst, size_t count) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(dst_data + i, float16_to_float32_sse2(
+            _mm_loadl_epi64((const __m128i*)(const void*)(src_data + i))));
     }
+    convert_row_f16_to_f32(src_data + i, dst_data + i, count - i);
+}
 
-    size_t total_bytes = element_size * total_elements;
+// SSE2 fused kernels: 4x4 float transpose with the conversion applied to
+// whole registers, scalar edges for leftover rows and columns
+static TENSOR_TARGET_SSE2 void transpose_block_f32_to_f16_sse2(const void* src, size_t src_stride,
+                                                                void* dst, size_t dst_stride,
+                                                                size_t rows, size_t cols) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    size_t full_rows = rows & ~(size_t)3;
+    size_t full_cols = cols & ~(size_t)3;
 
-    // Allocate memory for ONNX format data
-    result.data = malloc(total_bytes);
-    if (!result.data) {
-        safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_MEMORY_ALLOC ": %zu bytes", total_bytes);
-        return result;
+    for (size_t c = 0; c < full_cols; c += 4) {
+        for (size_t r = 0; r < full_rows; r += 4) {
+            const float* s = src_data + r * src_stride + c;
+            __m128 r0 = _mm_loadu_ps(s);
+            __m128 r1 = _mm_loadu_ps(s + src_stride);
+            __m128 r2 = _mm_loadu_ps(s + 2 * src_stride);
+            __m128 r3 = _mm_loadu_ps(s + 3 * src_stride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            uint16_t* d = dst_data + c * dst_stride + r;
+            _mm_storel_epi64((__m128i*)(void*)d, float32_to_float16_sse2(r0));
+            _mm_storel_epi64((__m128i*)(void*)(d + dst_stride), float32_to_float16_sse2(r1));
+            _mm_storel_epi64((__m128i*)(void*)(d + 2 * dst_stride), float32_to_float16_sse2(r2));
+            _mm_storel_epi64((__m128i*)(void*)(d + 3 * dst_stride), float32_to_float16_sse2(r3));
+        }
     }
+    if (full_rows < rows) {
+        transpose_block_f32_to_f16(src_data + full_rows * src_stride, src_stride,
+                                   dst_data + full_rows, dst_stride, rows - full_rows, full_cols);
+    }
+    if (full_cols < cols) {
+        transpose_block_f32_to_f16(src_data + full_cols, src_stride,
+                                   dst_data + full_cols * dst_stride, dst_stride,
+                                   rows, cols - full_cols);
+    }
+}
+
+static TENSOR_TARGET_SSE2 void transpose_block_f16_to_f32_sse2(const void* src, size_t src_stride,
+                                                                void* dst, size_t dst_stride,
+                                                                size_t rows, size_t cols) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    size_t full_rows = rows & ~(size_t)3;
+    size_t full_cols = cols & ~(size_t)3;
+
+    for (size_t c = 0; c < full_cols; c += 4) {
+        for (size_t r = 0; r < full_rows; r += 4) {
+            const uint16_t* s = src_data + r * src_stride + c;
+            __m128 r0 = float16_to_float32_sse2(_mm_loadl_epi64((const __m128i*)(const void*)s));
+            __m128 r1 = float16_to_float32_sse2(
+                _mm_loadl_epi64((const __m128i*)(const void*)(s + src_stride)));
+            __m128 r2 = float16_to_float32_sse2(
+                _mm_loadl_epi64((const __m128i*)(const void*)(s + 2 * src_stride)));
+            __m128 r3 = float16_to_float32_sse2(
+                _mm_loadl_epi64((const __m128i*)(const void*)(s + 3 * src_stride)));
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            float* d = dst_data + c * dst_stride + r;
+            _mm_storeu_ps(d, r0);
+            _mm_storeu_ps(d + dst_stride, r1);
+            _mm_storeu_ps(d + 2 * dst_stride, r2);
+            _mm_storeu_ps(d + 3 * dst_stride, r3);
+        }
+    }
+    if (full_rows < rows) {
+        transpose_block_f16_to_f32(src_data + full_rows * src_stride, src_stride,
+                                   dst_data + full_rows, dst_stride, rows - full_rows, full_cols);
+    }
+    if (full_cols < cols) {
+        transpose_block_f16_to_f32(src_data + full_cols, src_stride,
+                                   dst_data + full_cols * dst_stride, dst_stride,
+                                   rows, cols - full_cols);
+    }
+}
+#endif // TENSOR_HAVE_SSE2
+
+#if TENSOR_HAVE_F16C
+// F16C kernels: vcvtps2ph / vcvtph2ps around the AVX2 8x8 register transpose
+static TENSOR_TARGET_F16C void convert_row_f32_to_f16_f16c(const void* src, void* dst, size_t count) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src_data + i), _MM_FROUND_TO_NEAREST_INT));
+    }
+    convert_row_f32_to_f16(src_data + i, dst_data + i, count - i);
+}
+
+static TENSOR_TARGET_F16C void convert_row_f16_to_f32_f16c(const void* src, void* dst, size_t count) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        _mm256_storeu_ps(dst_data + i, _mm256_cvtph_ps(
+            _mm_loadu_si128((const __m128i*)(const void*)(src_data + i))));
+    }
+    convert_row_f16_to_f32(src_data + i, dst_data + i, count - i);
+}
+
+static TENSOR_TARGET_F16C void transpose_block_f32_to_f16_f16c(const void* src, size_t src_stride,
+                                                                void* dst, size_t dst_stride,
+                                                                size_t rows, size_t cols) {
+    const float* src_data = (const float*)src;
+    uint16_t* dst_data = (uint16_t*)dst;
+    size_t full_rows = rows & ~(size_t)7;
+    size_t full_cols = cols & ~(size_t)7;
+
+    for (size_t c = 0; c < full_cols; c += 8) {
+        for (size_t r = 0; r < full_rows; r += 8) {
+            __m256 v[8];
+            TENSOR_UNROLL
+            for (size_t i = 0; i < 8; i++) {
+                v[i] = _mm256_loadu_ps(src_data + (r + i) * src_stride + c);
+            }
+            transpose_8x8_ps_avx2(v);
+            TENSOR_UNROLL
+            for (size_t i = 0; i < 8; i++) {
+                _mm_storeu_si128((__m128i*)(void*)(dst_data + (c + i) * dst_stride + r),
+                                 _mm256_cvtps_ph(v[i], _MM_FROUND_TO_NEAREST_INT));
+            }
+        }
+    }
+    if (full_rows < rows) {
+        transpose_block_f32_to_f16(src_data + full_rows * src_stride, src_stride,
+                                   dst_data + full_rows, dst_stride, rows - full_rows, full_cols);
+    }
+    if (full_cols < cols) {
+        transpose_block_f32_to_f16(src_data + full_cols, src_stride,
+                                   dst_data + full_cols * dst_stride, dst_stride,
+                                   rows, cols - full_cols);
+    }
+}
+
+static TENSOR_TARGET_F16C void transpose_block_f16_to_f32_f16c(const void* src, size_t src_stride,
+                                                                void* dst, size_t dst_stride,
+                                                                size_t rows, size_t cols) {
+    const uint16_t* src_data = (const uint16_t*)src;
+    float* dst_data = (float*)dst;
+    size_t full_rows = rows & ~(size_t)7;
+    size_t full_cols = cols & ~(size_t)7;
+
+    for (size_t c = 0; c < full_cols; c += 8) {
+        for (size_t r = 0; r < full_rows; r += 8) {
+            __m256 v[8];
+            TENSOR_UNROLL
+            for (size_t i = 0; i < 8; i++) {
+                v[i] = _mm256_cvtph_ps(_mm_loadu_si128(
+                    (const __m128i*)(const void*)(src_data + (r + i) * src_stride + c)));
+            }
+            transpose_8x8_ps_avx2(v);
+            TENSOR_UNROLL
+            for (size_t i = 0; i < 8; i++) {
+                _mm256_storeu_ps(dst_data + (c + i) * dst_stride + r, v[i]);
+            }
+        }
+    }
+    if (full_rows < rows) {
+        transpose_block_f16_to_f32(src_data + full_rows * src_stride, src_stride,
+                                   dst_data + full_rows, dst_stride, rows - full_rows, full_cols);
+    }
+    if (full_cols < cols) {
+        transpose_block_f16_to_f32(src_data + full_cols, src_stride,
+                                   dst_data + full_cols * dst_stride, dst_stride,
+                                   rows, cols - full_cols);
+    }
+}
+#endif // TENSOR_HAVE_F16C
+
+/**
+ * Quantize one value: clamp(round_half_even(x / scale) + zero_point)
+ * x / scale is clamped to [qmin - zero_point, qmax - zero_point] before
+ * rounding; the bounds are integers, so this equals clamping afterwards.
+ * NaN inputs map to qmin, matching the SIMD kernels (maxps returns its
+ * second operand for NaN).
+ * @param x Float value
+ * @param scale Quantization scale (> 0)
+ * @param zero_point Zero point
+ * @param qmin Lowest representable value
+ * @param qmax Highest representable value
+ * @return Quantized value in [qmin, qmax]
+ */
+static inline int32_t quantize_value(float x, float scale, int32_t zero_point,
+                                     float qmin, float qmax) {
+    float lo = qmin - (float)zero_point;
+    float hi = qmax - (float)zero_point;
+    float v = x / scale;
+    if (!(v >= lo)) {
+        v = lo;
+    }
+    if (v > hi) {
+        v = hi;
+    }
+    // Round half to even from the truncated value; v is a small clamped
+    // value, so v - q is exact at any float evaluation precision
+    int32_t q = (int32_t)v;
+    float rem = v - (float)q;
+    if (rem > 0.5f || (rem == 0.5f && (q & 1))) {
+        q++;
+    } else if (rem < -0.5f || (rem == -0.5f && (q & 1))) {
+        q--;
+    }
+    return q + zero_point;
+}
+
+/**
+ * Quantization row kernel
+ * Element i uses scale[i * param_stride] and zero_point[i * param_stride];
+ * param_stride is 0 for a broadcast parameter and 1 for a per-element vector.
+ * @param src Float32 source elements
+ * @param dst Int8 or uint8 destination elements
+ * @param count Number of elements
+ * @param scale Scale pointer
+ * @param zero_point Zero point pointer, NULL for all zero
+ * @param param_stride 0 or 1
+ */
+typedef void (*quantize_row_fn)(const float* src, void* dst, size_t count,
+                                const float* scale, const int32_t* zero_point,
+                                size_t param_stride);
+
+#define TENSOR_DEFINE_QUANTIZE_ROW(suffix, type, qmin, qmax)                            \
+    static inline void quantize_row_##suffix(const float* src, void* dst, size_t count, \
+                                             const float* scale, const int32_t* zero_point, \
+                                             size_t param_stride) {                      \
+        type* dst_data = (type*)dst;                                                    \
+        for (size_t i = 0; i < count; i++) {                                            \
+            size_t p = i * param_stride;                                                \
+            int32_t zp = zero_point ? zero_point[p] : 0;                                \
+            dst_data[i] = (type)quantize_value(src[i], scale[p], zp, qmin, qmax);       \
+        }                                                                               \
+    }
+
+TENSOR_DEFINE_QUANTIZE_ROW(s8, int8_t, -128.0f, 127.0f)
+TENSOR_DEFINE_QUANTIZE_ROW(u8, uint8_t, 0.0f, 255.0f)
+
+#undef TENSOR_DEFINE_QUANTIZE_ROW
+
+#if TENSOR_HAVE_SSE2
+// SSE2 quantization: 16 elements per step. x / scale is clamped in float to
+// [qmin - zp, qmax - zp] before the round-half-even conversion and zp is
+// added as an integer afterwards, so the saturating packs never clip
+#define TENSOR_DEFINE_QUANTIZE_ROW_SSE2(suffix, qmin, qmax, pack)                                \
+    static TENSOR_TARGET_SSE2 void quantize_row_##suffix##_sse2(                                 \
+        const float* src, void* dst, size_t count,                                              \
+        const float* scale, const int32_t* zero_point, size_t param_stride) {                   \
+        uint8_t* dst_data = (uint8_t*)dst;                                                      \
+        const __m128 lo = _mm_set1_ps(qmin);                                                    \
+        const __m128 hi = _mm_set1_ps(qmax);                                                    \
+        __m128 s = _mm_set1_ps(scale[0]);                                                       \
+        __m128i z = _mm_set1_epi32(zero_point ? zero_point[0] : 0);                             \
+        size_t i = 0;                                                                           \
+        for (; i + 16 <= count; i += 16) {                                                      \
+            __m128i q[4];                                                                       \
+            TENSOR_UNROLL                                                                       \
+            for (size_t k = 0; k < 4; k++) {                                                    \
+                if (param_stride) {                                                             \
+                    s = _mm_loadu_ps(scale + i + 4 * k);                                        \
+                    z = zero_point ? _mm_loadu_si128(                                           \
+                            (const __m128i*)(const void*)(zero_point + i + 4 * k))              \
+                                   : _mm_setzero_si128();                                       \
+                }                                                                               \
+                __m128 zf = _mm_cvtepi32_ps(z);                                                 \
+                __m128 v = _mm_div_ps(_mm_loadu_ps(src + i + 4 * k), s);                        \
+                v = _mm_min_ps(_mm_max_ps(v, _mm_sub_ps(lo, zf)), _mm_sub_ps(hi, zf));          \
+                q[k] = _mm_add_epi32(_mm_cvtps_epi32(v), z);                                    \
+            }                                                                                   \
+            __m128i packed = pack(_mm_packs_epi32(q[0], q[1]), _mm_packs_epi32(q[2], q[3]));    \
+            _mm_storeu_si128((__m128i*)(void*)(dst_data + i), packed);                          \
+        }                                                                                       \
+        quantize_row_##suffix(src + i, dst_data + i, count - i, scale + i * param_stride,      \
+                              zero_point ? zero_point + i * param_stride : NULL, param_stride); \
+    }
+
+TENSOR_DEFINE_QUANTIZE_ROW_SSE2(s8, -128.0f, 127.0f, _mm_packs_epi16)
+TENSOR_DEFINE_QUANTIZE_ROW_SSE2(u8, 0.0f, 255.0f, _mm_packus_epi16)
+
+#undef TENSOR_DEFINE_QUANTIZE_ROW_SSE2
+#endif // TENSOR_HAVE_SSE2
+
+#if TENSOR_HAVE_AVX2
+// AVX2 quantization: 16 elements per step; the in-lane 32->16 pack is
+// reordered with a 64-bit permute before the final 16->8 pack
+#define TENSOR_DEFINE_QUANTIZE_ROW_AVX2(suffix, qmin, qmax, pack)                                \
+    static TENSOR_TARGET_AVX2 void quantize_row_##suffix##_avx2(                                 \
+        const float* src, void* dst, size_t count,                                              \
+        const float* scale, const int32_t* zero_point, size_t param_stride) {                   \
+        uint8_t* dst_data = (uint8_t*)dst;                                                      \
+        const __m256 lo = _mm256_set1_ps(qmin);                                                 \
+        const __m256 hi = _mm256_set1_ps(qmax);                                                 \
+        __m256 s = _mm256_set1_ps(scale[0]);                                                    \
+        __m256i z = _mm256_set1_epi32(zero_point ? zero_point[0] : 0);                          \
+        size_t i = 0;                                                                           \
+        for (; i + 16 <= count; i += 16) {                                                      \
+            __m256i q[2];                                                                       \
+            TENSOR_UNROLL                                                                       \
+            for (size_t k = 0; k < 2; k++) {                                                    \
+                if (param_stride) {                                                             \
+                    s = _mm256_loadu_ps(scale + i + 8 * k);                                     \
+                    z = zero_point ? _mm256_loadu_si256(                                        \
+                            (const __m256i*)(const void*)(zero_point + i + 8 * k))              \
+                                   : _mm256_setzero_si256();                                    \
+                }                                                                               \
+                __m256 zf = _mm256_cvtepi32_ps(z);                                              \
+                __m256 v = _mm256_div_ps(_mm256_loadu_ps(src + i + 8 * k), s);                  \
+                v = _mm256_min_ps(_mm256_max_ps(v, _mm256_sub_ps(lo, zf)), _mm256_sub_ps(hi, zf)); \
+                q[k] = _mm256_add_epi32(_mm256_cvtps_epi32(v), z);                              \
+            }                                                                                   \
+            __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(q[0], q[1]), 0xD8);     \
+            __m128i packed = pack(_mm256_castsi256_si128(words),                                \
+                                  _mm256_extracti128_si256(words, 1));                          \
+            _mm_storeu_si128((__m128i*)(void*)(dst_data + i), packed);                          \
+        }                                                                                       \
+        quantize_row_##suffix(src + i, dst_data + i, count - i, scale + i * param_stride,      \
+                              zero_point ? zero_point + i * param_stride : NULL, param_stride); \
+    }
+
+TENSOR_DEFINE_QUANTIZE_ROW_AVX2(s8, -128.0f, 127.0f, _mm_packs_epi16)
+TENSOR_DEFINE_QUANTIZE_ROW_AVX2(u8, 0.0f, 255.0f, _mm_packus_epi16)
+
+#undef TENSOR_DEFINE_QUANTIZE_ROW_AVX2
+#endif // TENSOR_HAVE_AVX2
+
+/**
+ * Dequantization row kernel: dst[i] = (src[i] - zero_point) * scale
+ * Parameters follow the same param_stride convention as quantize_row_fn.
+ * @param src Int8 or uint8 source elements
+ * @param dst Float32 destination elements
+ * @param count Number of elements
+ * @param scale Scale pointer
+ * @param zero_point Zero point pointer, NULL for all zero
+ * @param param_stride 0 or 1
+ */
+typedef void (*dequantize_row_fn)(const void* src, float* dst, size_t count,
+                                  const float* scale, const int32_t* zero_point,
+                                  size_t param_stride);
+
+#define TENSOR_DEFINE_DEQUANTIZE_ROW(suffix, type)                                           \
+    static inline void dequantize_row_##suffix(const void* src, float* dst, size_t count,    \
+                                               const float* scale, const int32_t* zero_point, \
+                                               size_t param_stride) {                         \
+        const type* src_data = (const type*)src;                                             \
+        for (size_t i = 0; i < count; i++) {                                                 \
+            size_t p = i * param_stride;                                                     \
+            int32_t zp = zero_point ? zero_point[p] : 0;                                     \
+            dst[i] = (float)((int32_t)src_data[i] - zp) * scale[p];                          \
+        }                                                                                    \
+    }
+
+TENSOR_DEFINE_DEQUANTIZE_ROW(s8, int8_t)
+TENSOR_DEFINE_DEQUANTIZE_ROW(u8, uint8_t)
+
+#undef TENSOR_DEFINE_DEQUANTIZE_ROW
+
+#if TENSOR_HAVE_SSE2
+/**
+ * Widen 16 int8 / uint8 values to four vectors of int32 (SSE2)
+ */
+static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE void widen_s8_sse2(__m128i x, __m128i* out) {
+    __m128i lo = _mm_srai_epi16(_mm_unpacklo_epi8(x, x), 8);
+    __m128i hi = _mm_srai_epi16(_mm_unpackhi_epi8(x, x), 8);
+    out[0] = _mm_srai_epi32(_mm_unpacklo_epi16(lo, lo), 16);
+    out[1] = _mm_srai_epi32(_mm_unpackhi_epi16(lo, lo), 16);
+    out[2] = _mm_srai_epi32(_mm_unpacklo_epi16(hi, hi), 16);
+    out[3] = _mm_srai_epi32(_mm_unpackhi_epi16(hi, hi), 16);
+}
+
+static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE void widen_u8_sse2(__m128i x, __m128i* out) {
+    __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_unpacklo_epi8(x, zero);
+    __m128i hi = _mm_unpackhi_epi8(x, zero);
+    out[0] = _mm_unpacklo_epi16(lo, zero);
+    out[1] = _mm_unpackhi_epi16(lo, zero);
+    out[2] = _mm_unpacklo_epi16(hi, zero);
+    out[3] = _mm_unpackhi_epi16(hi, zero);
+}
+
+#define TENSOR_DEFINE_DEQUANTIZE_ROW_SSE2(suffix)                                                \
+    static TENSOR_TARGET_SSE2 void dequantize_row_##suffix##_sse2(                               \
+        const void* src, float* dst, size_t count,                                              \
+        const float* scale, const int32_t* zero_point, size_t param_stride) {                   \
+        const uint8_t* src_data = (const uint8_t*)src;                                          \
+        __m128 s = _mm_set1_ps(scale[0]);                                                       \
+        __m128i z = _mm_set1_epi32(zero_point ? zero_point[0] : 0);                             \
+        size_t i = 0;                                                                           \
+        for (; i + 16 <= count; i += 16) {                                                      \
+            __m128i q[4];                                                                       \
+            widen_##suffix##_sse2(_mm_loadu_si128((const __m128i*)(const void*)(src_data + i)), q); \
+            TENSOR_UNROLL                                                                       \
+            for (size_t k = 0; k < 4; k++) {                                                    \
+                if (param_stride) {                                                             \
+                    s = _mm_loadu_ps(scale + i + 4 * k);                                        \
+                    z = zero_point ? _mm_loadu_si128(                                           \
+                            (const __m128i*)(const void*)(zero_point + i + 4 * k))              \
+                                   : _mm_setzero_si128();                                       \
+                }                                                                               \
+                _mm_storeu_ps(dst + i + 4 * k,                                                  \
+                              _mm_mul_ps(_mm_cvtepi32_ps(_mm_sub_epi32(q[k], z)), s));          \
+            }                                                                                   \
+        }                                                                                       \
+        dequantize_row_##suffix(src_data + i, dst + i, count - i, scale + i * param_stride,    \
+                                zero_point ? zero_point + i * param_stride : NULL,             \
+                                param_stride);                                                  \
+    }
+
+TENSOR_DEFINE_DEQUANTIZE_ROW_SSE2(s8)
+TENSOR_DEFINE_DEQUANTIZE_ROW_SSE2(u8)
+
+#undef TENSOR_DEFINE_DEQUANTIZE_ROW_SSE2
+#endif // TENSOR_HAVE_SSE2
+
+#if TENSOR_HAVE_AVX2
+#define TENSOR_DEFINE_DEQUANTIZE_ROW_AVX2(suffix, widen)                                         \
+    static TENSOR_TARGET_AVX2 void dequantize_row_##suffix##_avx2(                               \
+        const void* src, float* dst, size_t count,                                              \
+        const float* scale, const int32_t* zero_point, size_t param_stride) {                   \
+        const uint8_t* src_data = (const uint8_t*)src;                                          \
+        __m256 s = _mm256_set1_ps(scale[0]);                                                    \
+        __m256i z = _mm256_set1_epi32(zero_point ? zero_point[0] : 0);                          \
+        size_t i = 0;                                                                           \
+        for (; i + 8 <= count; i += 8) {                                                        \
+            __m256i q = widen(_mm_loadl_epi64((const __m128i*)(const void*)(src_data + i)));    \
+            if (param_stride) {                                                                 \
+                s = _mm256_loadu_ps(scale + i);                                                 \
+                z = zero_point ? _mm256_loadu_si256((const __m256i*)(const void*)(zero_point + i)) \
+                               : _mm256_setzero_si256();                                        \
+            }                                                                                   \
+            _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_sub_epi32(q, z)), s)); \
+        }                                                                                       \
+        dequantize_row_##suffix(src_data + i, dst + i, count - i, scale + i * param_stride,    \
+                                zero_point ? zero_point + i * param_stride : NULL,             \
+                                param_stride);                                                  \
+    }
+
+TENSOR_DEFINE_DEQUANTIZE_ROW_AVX2(s8, _mm256_cvtepi8_epi32)
+TENSOR_DEFINE_DEQUANTIZE_ROW_AVX2(u8, _mm256_cvtepu8_epi32)
+
+#undef TENSOR_DEFINE_DEQUANTIZE_ROW_AVX2
+#endif // TENSOR_HAVE_AVX2
+
+/**
+ * Channel shuffle kernel between interleaved pixels and channel planes
+ * Deinterleave moves channel c of pixel p from src[p * C + c] to
+ * dst[c * plane_stride + p]; interleave is the inverse, with plane_stride
+ * applying to src. Element bits are moved unchanged.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param count Number of pixels
+ * @param plane_stride Distance between channel planes (elements)
+ */
+typedef void (*channel_shuffle_fn)(const void* src, void* dst, size_t count, size_t plane_stride);
+
+#define TENSOR_DEFINE_CHANNEL_SHUFFLE(bits, type, channels)                                 \
+    static inline void deinterleave_##bits##_c##channels(const void* src, void* dst,       \
+                                                         size_t count, size_t plane_stride) { \
+        const char* src_data = (const char*)src;                                           \
+        char* dst_data = (char*)dst;                                                       \
+        for (size_t p = 0; p < count; p++) {                                               \
+            for (size_t c = 0; c < (channels); c++) {                                      \
+                memcpy(dst_data + (c * plane_stride + p) * sizeof(type),                   \
+                       src_data + (p * (channels) + c) * sizeof(type), sizeof(type));      \
+            }                                                                              \
+        }                                                                                  \
+    }                                                                                      \
+    static inline void interleave_##bits##_c##channels(const void* src, void* dst,         \
+                                                       size_t count, size_t plane_stride) { \
+        const char* src_data = (const char*)src;                                           \
+        char* dst_data = (char*)dst;                                                       \
+        for (size_t p = 0; p < count; p++) {                                               \
+            for (size_t c = 0; c < (channels); c++) {                                      \
+                memcpy(dst_data + (p * (channels) + c) * sizeof(type),                     \
+                       src_data + (c * plane_stride + p) * sizeof(type), sizeof(type));    \
+            }                                                                              \
+        }                                                                                  \
+    }
+
+TENSOR_DEFINE_CHANNEL_SHUFFLE(8, uint8_t, 2)
+TENSOR_DEFINE_CHANNEL_SHUFFLE(8, uint8_t, 3)
+TENSOR_DEFINE_CHANNEL_SHUFFLE(8, uint8_t, 4)
+TENSOR_DEFINE_CHANNEL_SHUFFLE(32, uint32_t, 2)
+TENSOR_DEFINE_CHANNEL_SHUFFLE(32, uint32_t, 3)
+TENSOR_DEFINE_CHANNEL_SHUFFLE(32, uint32_t, 4)
+
+#undef TENSOR_DEFINE_CHANNEL_SHUFFLE
+
+#if TENSOR_HAVE_SSE2
+/**
+ * SSE2 channel shuffles: 16 pixels per step for 1-byte, 4 for 4-byte elements
+ * 1-byte channels are split with mask/shift + saturating packs (exact for
+ * values that were zero-extended), 4-byte channels with float shuffles.
+ */
+static TENSOR_TARGET_SSE2 void deinterleave_8_c2_sse2(const void* src, void* dst,
+                                                      size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    const __m128i mask = _mm_set1_epi16(0xff);
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        const __m128i* in = (const __m128i*)(const void*)(src_data + p * 2);
+        __m128i a = _mm_loadu_si128(in);
+        __m128i b = _mm_loadu_si128(in + 1);
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + p),
+                         _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask)));
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + plane_stride + p),
+                         _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8)));
+    }
+    deinterleave_8_c2(src_data + p * 2, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void interleave_8_c2_sse2(const void* src, void* dst,
+                                                    size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        __m128i c0 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + p));
+        __m128i c1 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + plane_stride + p));
+        __m128i* out = (__m128i*)(void*)(dst_data + p * 2);
+        _mm_storeu_si128(out, _mm_unpacklo_epi8(c0, c1));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi8(c0, c1));
+    }
+    interleave_8_c2(src_data + p, dst_data + p * 2, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void deinterleave_8_c4_sse2(const void* src, void* dst,
+                                                      size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    const __m128i mask = _mm_set1_epi16(0xff);
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        const __m128i* in = (const __m128i*)(const void*)(src_data + p * 4);
+        __m128i a = _mm_loadu_si128(in);
+        __m128i b = _mm_loadu_si128(in + 1);
+        __m128i c = _mm_loadu_si128(in + 2);
+        __m128i d = _mm_loadu_si128(in + 3);
+        // Channels 0/2 and 1/3, then split each pair again
+        __m128i e0 = _mm_packus_epi16(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+        __m128i e1 = _mm_packus_epi16(_mm_and_si128(c, mask), _mm_and_si128(d, mask));
+        __m128i o0 = _mm_packus_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+        __m128i o1 = _mm_packus_epi16(_mm_srli_epi16(c, 8), _mm_srli_epi16(d, 8));
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + p),
+                         _mm_packus_epi16(_mm_and_si128(e0, mask), _mm_and_si128(e1, mask)));
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + plane_stride + p),
+                         _mm_packus_epi16(_mm_and_si128(o0, mask), _mm_and_si128(o1, mask)));
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + 2 * plane_stride + p),
+                         _mm_packus_epi16(_mm_srli_epi16(e0, 8), _mm_srli_epi16(e1, 8)));
+        _mm_storeu_si128((__m128i*)(void*)(dst_data + 3 * plane_stride + p),
+                         _mm_packus_epi16(_mm_srli_epi16(o0, 8), _mm_srli_epi16(o1, 8)));
+    }
+    deinterleave_8_c4(src_data + p * 4, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void interleave_8_c4_sse2(const void* src, void* dst,
+                                                    size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        __m128i c0 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + p));
+        __m128i c1 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + plane_stride + p));
+        __m128i c2 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + 2 * plane_stride + p));
+        __m128i c3 = _mm_loadu_si128((const __m128i*)(const void*)(src_data + 3 * plane_stride + p));
+        __m128i lo01 = _mm_unpacklo_epi8(c0, c1);
+        __m128i hi01 = _mm_unpackhi_epi8(c0, c1);
+        __m128i lo23 = _mm_unpacklo_epi8(c2, c3);
+        __m128i hi23 = _mm_unpackhi_epi8(c2, c3);
+        __m128i* out = (__m128i*)(void*)(dst_data + p * 4);
+        _mm_storeu_si128(out, _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi01, hi23));
+    }
+    interleave_8_c4(src_data + p, dst_data + p * 4, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void deinterleave_32_c2_sse2(const void* src, void* dst,
+                                                       size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        __m128 a = _mm_loadu_ps(src_data + p * 2);
+        __m128 b = _mm_loadu_ps(src_data + p * 2 + 4);
+        _mm_storeu_ps(dst_data + p, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dst_data + plane_stride + p, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+    }
+    deinterleave_32_c2(src_data + p * 2, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void interleave_32_c2_sse2(const void* src, void* dst,
+                                                     size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        __m128 c0 = _mm_loadu_ps(src_data + p);
+        __m128 c1 = _mm_loadu_ps(src_data + plane_stride + p);
+        _mm_storeu_ps(dst_data + p * 2, _mm_unpacklo_ps(c0, c1));
+        _mm_storeu_ps(dst_data + p * 2 + 4, _mm_unpackhi_ps(c0, c1));
+    }
+    interleave_32_c2(src_data + p, dst_data + p * 2, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void deinterleave_32_c3_sse2(const void* src, void* dst,
+                                                       size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        // a = [r0 g0 b0 r1], b = [g1 b1 r2 g2], c = [b2 r3 g3 b3]
+        __m128 a = _mm_loadu_ps(src_data + p * 3);
+        __m128 b = _mm_loadu_ps(src_data + p * 3 + 4);
+        __m128 c = _mm_loadu_ps(src_data + p * 3 + 8);
+        __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));     // r2 g2 r3 g3
+        __m128 v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));     // g0 b0 g1 b1
+        _mm_storeu_ps(dst_data + p, _mm_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0)));
+        _mm_storeu_ps(dst_data + plane_stride + p, _mm_shuffle_ps(v, u, _MM_SHUFFLE(3, 1, 2, 0)));
+        _mm_storeu_ps(dst_data + 2 * plane_stride + p,
+                      _mm_shuffle_ps(v, c, _MM_SHUFFLE(3, 0, 3, 1)));
+    }
+    deinterleave_32_c3(src_data + p * 3, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void interleave_32_c3_sse2(const void* src, void* dst,
+                                                     size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        __m128 r = _mm_loadu_ps(src_data + p);
+        __m128 g = _mm_loadu_ps(src_data + plane_stride + p);
+        __m128 b = _mm_loadu_ps(src_data + 2 * plane_stride + p);
+        __m128 rg0 = _mm_shuffle_ps(r, g, _MM_SHUFFLE(0, 0, 0, 0));   // r0 r0 g0 g0
+        __m128 br1 = _mm_shuffle_ps(b, r, _MM_SHUFFLE(1, 1, 0, 0));   // b0 b0 r1 r1
+        __m128 gb1 = _mm_shuffle_ps(g, b, _MM_SHUFFLE(1, 1, 1, 1));   // g1 g1 b1 b1
+        __m128 rg2 = _mm_shuffle_ps(r, g, _MM_SHUFFLE(2, 2, 2, 2));   // r2 r2 g2 g2
+        __m128 br3 = _mm_shuffle_ps(b, r, _MM_SHUFFLE(3, 3, 2, 2));   // b2 b2 r3 r3
+        __m128 gb3 = _mm_shuffle_ps(g, b, _MM_SHUFFLE(3, 3, 3, 3));   // g3 g3 b3 b3
+        _mm_storeu_ps(dst_data + p * 3, _mm_shuffle_ps(rg0, br1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dst_data + p * 3 + 4, _mm_shuffle_ps(gb1, rg2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(dst_data + p * 3 + 8, _mm_shuffle_ps(br3, gb3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+    interleave_32_c3(src_data + p, dst_data + p * 3, count - p, plane_stride);
+}
+
+/**
+ * 4x4 transpose of 32-bit lanes (its own inverse)
+ */
+static TENSOR_TARGET_SSE2 TENSOR_FORCE_INLINE void transpose_4x4_ps_sse2(__m128* r) {
+    __m128 t0 = _mm_unpacklo_ps(r[0], r[1]);
+    __m128 t1 = _mm_unpacklo_ps(r[2], r[3]);
+    __m128 t2 = _mm_unpackhi_ps(r[0], r[1]);
+    __m128 t3 = _mm_unpackhi_ps(r[2], r[3]);
+    r[0] = _mm_movelh_ps(t0, t1);
+    r[1] = _mm_movehl_ps(t1, t0);
+    r[2] = _mm_movelh_ps(t2, t3);
+    r[3] = _mm_movehl_ps(t3, t2);
+}
+
+static TENSOR_TARGET_SSE2 void deinterleave_32_c4_sse2(const void* src, void* dst,
+                                                       size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        __m128 r[4];
+        TENSOR_UNROLL
+        for (size_t k = 0; k < 4; k++) {
+            r[k] = _mm_loadu_ps(src_data + (p + k) * 4);
+        }
+        transpose_4x4_ps_sse2(r);
+        TENSOR_UNROLL
+        for (size_t k = 0; k < 4; k++) {
+            _mm_storeu_ps(dst_data + k * plane_stride + p, r[k]);
+        }
+    }
+    deinterleave_32_c4(src_data + p * 4, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_SSE2 void interleave_32_c4_sse2(const void* src, void* dst,
+                                                     size_t count, size_t plane_stride) {
+    const float* src_data = (const float*)src;
+    float* dst_data = (float*)dst;
+    size_t p = 0;
+    for (; p + 4 <= count; p += 4) {
+        __m128 r[4];
+        TENSOR_UNROLL
+        for (size_t k = 0; k < 4; k++) {
+            r[k] = _mm_loadu_ps(src_data + k * plane_stride + p);
+        }
+        transpose_4x4_ps_sse2(r);
+        TENSOR_UNROLL
+        for (size_t k = 0; k < 4; k++) {
+            _mm_storeu_ps(dst_data + (p + k) * 4, r[k]);
+        }
+    }
+    interleave_32_c4(src_data + p, dst_data + p * 4, count - p, plane_stride);
+}
+#endif // TENSOR_HAVE_SSE2
+
+#if TENSOR_HAVE_AVX2
+/**
+ * Split 16 three-channel 1-byte pixels into one vector per channel (SSSE3 shuffles)
+ */
+static TENSOR_TARGET_AVX2 TENSOR_FORCE_INLINE void deinterleave16_8_c3_avx2(const uint8_t* src,
+                                                                           __m128i* ch) {
+    const __m128i* in = (const __m128i*)(const void*)src;
+    __m128i a = _mm_loadu_si128(in);
+    __m128i b = _mm_loadu_si128(in + 1);
+    __m128i c = _mm_loadu_si128(in + 2);
+    ch[0] = _mm_or_si128(
+        _mm_or_si128(
+            _mm_shuffle_epi8(a, _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13)));
+    ch[1] = _mm_or_si128(
+        _mm_or_si128(
+            _mm_shuffle_epi8(a, _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14)));
+    ch[2] = _mm_or_si128(
+        _mm_or_si128(
+            _mm_shuffle_epi8(a, _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1))),
+        _mm_shuffle_epi8(c, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15)));
+}
+
+/**
+ * Split 16 four-channel 1-byte pixels into one vector per channel (SSSE3 shuffles)
+ */
+static TENSOR_TARGET_AVX2 TENSOR_FORCE_INLINE void deinterleave16_8_c4_avx2(const uint8_t* src,
+                                                                           __m128i* ch) {
+    // Group each 4-pixel load by channel, then a 4x4 transpose of 32-bit lanes
+    const __m128i k4 = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    const __m128i* in = (const __m128i*)(const void*)src;
+    __m128i a = _mm_shuffle_epi8(_mm_loadu_si128(in), k4);
+    __m128i b = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), k4);
+    __m128i c = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), k4);
+    __m128i d = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), k4);
+    __m128i t0 = _mm_unpacklo_epi32(a, b);
+    __m128i t1 = _mm_unpacklo_epi32(c, d);
+    __m128i t2 = _mm_unpackhi_epi32(a, b);
+    __m128i t3 = _mm_unpackhi_epi32(c, d);
+    ch[0] = _mm_unpacklo_epi64(t0, t1);
+    ch[1] = _mm_unpackhi_epi64(t0, t1);
+    ch[2] = _mm_unpacklo_epi64(t2, t3);
+    ch[3] = _mm_unpackhi_epi64(t2, t3);
+}
+
+static TENSOR_TARGET_AVX2 void deinterleave_8_c3_avx2(const void* src, void* dst,
+                                                      size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        __m128i ch[3];
+        deinterleave16_8_c3_avx2(src_data + p * 3, ch);
+        TENSOR_UNROLL
+        for (size_t k = 0; k < 3; k++) {
+            _mm_storeu_si128((__m128i*)(void*)(dst_data + k * plane_stride + p), ch[k]);
+        }
+    }
+    deinterleave_8_c3(src_data + p * 3, dst_data + p, count - p, plane_stride);
+}
+
+static TENSOR_TARGET_AVX2 void interleave_8_c3_avx2(const void* src, void* dst,
+                                                    size_t count, size_t plane_stride) {
+    const uint8_t* src_data = (const uint8_t*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+    size_t p = 0;
+    for (; p + 16 <= count; p += 16) {
+        __m128i r = _mm_loadu_si128((const __m128i*)(const void*)(src_data + p));
+        __m128i g = _mm_loadu_si128((const __m128i*)(const void*)(src_data + plane_stride + p));
+        __m128i b = _mm_loadu_si128((const __m128i*)(const void*)(src_data + 2 * plane_stride + p));
+        __m128i* out = (__m128i*)(void*)(dst_data + p * 3);
+        _mm_storeu_si128(out, _mm_or_si128(
+            _mm_or_si128(
+                _mm_shuffle_epi8(r, _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5)),
+                _mm_shuffle_epi8(g, _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1))),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1))));
+        _mm_storeu_si128(out + 1, _mm_or_si128(
+            _mm_or_si128(
+                _mm_shuffle_epi8(r, _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1)),
+                _mm_shuffle_epi8(g, _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10))),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1))));
+        _mm_storeu_si128(out + 2, _mm_or_si128(
+            _mm_or_si128(
+                _mm_shuffle_epi8(r, _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1)),
+                _mm_shuffle_epi8(g, _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1))),
+            _mm_shuffle_epi8(b, _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15))));
+    }
+    interleave_8_c3(src_data + p, dst_data + p * 3, count - p, plane_stride);
+}
+#endif // TENSOR_HAVE_AVX2
+
+/**
+ * Pixel normalization kernel: interleaved uint8 pixels to float32 planes
+ * dst[c * plane_stride + p] = (src[p * channels + src_c] - mean[c]) * inv_std[c],
+ * where src_c is c with channels 0 and 2 exchanged when swap_rb is set.
+ * @param src Interleaved uint8 pixels
+ * @param dst First destination plane
+ * @param count Number of pixels
+ * @param channels Channels per pixel
+ * @param plane_stride Distance between destination planes (elements)
+ * @param mean Per destination channel mean, NULL for 0
+ * @param inv_std Per destination channel 1 / std, NULL for 1
+ * @param swap_rb Exchange channels 0 and 2 (BGR <-> RGB)
+ */
+typedef void (*normalize_pixels_fn)(const uint8_t* src, float* dst, size_t count,
+                                    size_t channels, size_t plane_stride,
+                                    const float* mean, const float* inv_std, bool swap_rb);
+
+static inline size_t get_normalize_src_channel(size_t channel, bool swap_rb) {
+    if (swap_rb && (channel == 0 || channel == 2)) {
+        return 2 - channel;
+    }
+    return channel;
+}
+
+static inline void normalize_pixels(const uint8_t* src, float* dst, size_t count,
+                                    size_t channels, size_t plane_stride,
+                                    const float* mean, const float* inv_std, bool swap_rb) {
+    for (size_t c = 0; c < channels; c++) {
+        const uint8_t* src_channel = src + get_normalize_src_channel(c, swap_rb);
+        float* dst_plane = dst + c * plane_stride;
+        float m = mean ? mean[c] : 0.0f;
+        float s = inv_std ? inv_std[c] : 1.0f;
+        for (size_t p = 0; p < count; p++) {
+            dst_plane[p] = ((float)src_channel[p * channels] - m) * s;
+        }
+    }
+}
+
+#if TENSOR_HAVE_AVX2
+/**
+ * Normalize 16 uint8 values of one channel into 16 floats (AVX2)
+ */
+static TENSOR_TARGET_AVX2 TENSOR_FORCE_INLINE void normalize_store16_avx2(__m128i x, float* dst,
+                                                                         __m256 m, __m256 s) {
+    __m256 lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(x));
+    __m256 hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(x, 8)));
+    _mm256_storeu_ps(dst, _mm256_mul_ps(_mm256_sub_ps(lo, m), s));
+    _mm256_storeu_ps(dst + 8, _mm256_mul_ps(_mm256_sub_ps(hi, m), s));
+}
+
+/**
+ * AVX2 pixel normalization
+ * One, three and four channels deinterleave 16 pixels per step with byte
+ * shuffles; other channel counts and tails use the scalar kernel.
+ */
+static TENSOR_TARGET_AVX2 void normalize_pixels_avx2(const uint8_t* src, float* dst, size_t count,
+                                                     size_t channels, size_t plane_stride,
+                                                     const float* mean, const float* inv_std,
+                                                     bool swap_rb) {
+    __m256 m[4], s[4];
+    size_t p = 0;
+
+    if (channels != 1 && channels != 3 && channels != 4) {
+        normalize_pixels(src, dst, count, channels, plane_stride, mean, inv_std, swap_rb);
+        return;
+    }
+    for (size_t c = 0; c < channels; c++) {
+        m[c] = _mm256_set1_ps(mean ? mean[c] : 0.0f);
+        s[c] = _mm256_set1_ps(inv_std ? inv_std[c] : 1.0f);
+    }
+
+    if (channels == 1) {
+        for (; p + 16 <= count; p += 16) {
+            normalize_store16_avx2(_mm_loadu_si128((const __m128i*)(const void*)(src + p)),
+                                   dst + p, m[0], s[0]);
+        }
+    } else {
+        for (; p + 16 <= count; p += 16) {
+            __m128i ch[4];
+            if (channels == 3) {
+                deinterleave16_8_c3_avx2(src + p * 3, ch);
+            } else {
+                deinterleave16_8_c4_avx2(src + p * 4, ch);
+            }
+            for (size_t k = 0; k < channels; k++) {
+                normalize_store16_avx2(ch[get_normalize_src_channel(k, swap_rb)],
+                                       dst + k * plane_stride + p, m[k], s[k]);
+            }
+        }
+    }
+    normalize_pixels(src + p * channels, dst + p, count - p, channels, plane_stride,
+                     mean, inv_std, swap_rb);
+}
+#endif // TENSOR_HAVE_AVX2
+
+/**
+ * Instruction set levels of the conversion kernels
+ */
+typedef enum {
+    TENSOR_ISA_SCALAR = 0,
+    TENSOR_ISA_SSE2 = 1,
+    TENSOR_ISA_AVX2 = 2,    // AVX2 + F16C
+    TENSOR_ISA_AVX512 = 3   // AVX512F + AVX512BW (+ F16C)
+} tensor_isa_t;
+
+/**
+ * Data type conversions fused into the layout kernels
+ */
+typedef enum {
+    TENSOR_CAST_F32_TO_F16 = 0,
+    TENSOR_CAST_F16_TO_F32 = 1,
+    TENSOR_CAST_COUNT = 2
+} tensor_cast_t;
+
+/**
+ * Kernel table selected once per process for the running CPU
+ * Transpose entries are indexed by log2(element_size) for 1/2/4/8-byte types,
+ * conversion entries by tensor_cast_t.
+ */
+typedef struct {
+    tensor_isa_t isa;                                   // Selected instruction set
+    transpose_block_fn transpose_block[4];              // Block kernels
+    size_t transpose_block_edge[4];                     // Register block edge (elements)
+    convert_row_fn convert_row[TENSOR_CAST_COUNT];      // Contiguous conversion kernels
+    transpose_block_fn transpose_cast_block[TENSOR_CAST_COUNT]; // Fused transpose + conversion
+    size_t transpose_cast_block_edge[TENSOR_CAST_COUNT];        // Register block edge (elements)
+    quantize_row_fn quantize_row[2];                    // Float32 -> int8 / uint8
+    dequantize_row_fn dequantize_row[2];                // Int8 / uint8 -> float32
+    normalize_pixels_fn normalize_pixels;               // Uint8 HWC -> normalized float32 CHW
+    channel_shuffle_fn deinterleave[2][3];              // HWC -> CHW, [1 / 4-byte][C - 2], or NULL
+    channel_shuffle_fn interleave[2][3];                // CHW -> HWC, [1 / 4-byte][C - 2], or NULL
+} tensor_kernel_table_t;
+
+/**
+ * Check for F16C support (runtime dispatch builds)
+ * @return Returns true if the CPU reports F16C
+ */
+static inline bool detect_cpu_f16c(void) {
+#if TENSOR_RUNTIME_DISPATCH
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (ecx & bit_F16C) != 0;
+#else
+    return TENSOR_HAVE_F16C != 0;
+#endif
+}
+
+/**
+ * Detect the best instruction set supported by the running CPU and OS
+ * @return Highest supported ISA level
+ */
+static inline tensor_isa_t detect_cpu_isa(void) {
+#if TENSOR_RUNTIME_DISPATCH
+    __builtin_cpu_init();
+    bool f16c = detect_cpu_f16c();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") && f16c) {
+        return TENSOR_ISA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && f16c) {
+        return TENSOR_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return TENSOR_ISA_SSE2;
+    }
+    return TENSOR_ISA_SCALAR;
+#elif TENSOR_HAVE_AVX512
+    return TENSOR_ISA_AVX512;
+#elif TENSOR_HAVE_AVX2
+    return TENSOR_ISA_AVX2;
+#elif TENSOR_HAVE_SSE2
+    return TENSOR_ISA_SSE2;
+#else
+    return TENSOR_ISA_SCALAR;
+#endif
+}
+
+/**
+ * Get printable ISA name
+ * @param isa ISA level
+ * @return Lowercase name, also accepted by TENSOR_CONVERTER_ISA
+ */
+static inline const char* get_isa_name(tensor_isa_t isa) {
+    switch (isa) {
+        case TENSOR_ISA_SCALAR:
+            return "scalar";
+        case TENSOR_ISA_SSE2:
+            return "sse2";
+        case TENSOR_ISA_AVX2:
+            return "avx2";
+        case TENSOR_ISA_AVX512:
+            return "avx512";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Fill a kernel table for an ISA level
+ * @param table Table to fill
+ * @param isa ISA level, must be supported by the running CPU
+ */
+static inline void init_kernel_table(tensor_kernel_table_t* table, tensor_isa_t isa) {
+    table->isa = isa;
+    table->transpose_block[0] = transpose_block_8;
+    table->transpose_block[1] = transpose_block_16;
+    table->transpose_block[2] = transpose_block_32;
+    table->transpose_block[3] = transpose_block_64;
+    for (size_t i = 0; i < 4; i++) {
+        table->transpose_block_edge[i] = 1;
+    }
+    table->convert_row[TENSOR_CAST_F32_TO_F16] = convert_row_f32_to_f16;
+    table->convert_row[TENSOR_CAST_F16_TO_F32] = convert_row_f16_to_f32;
+    table->transpose_cast_block[TENSOR_CAST_F32_TO_F16] = transpose_block_f32_to_f16;
+    table->transpose_cast_block[TENSOR_CAST_F16_TO_F32] = transpose_block_f16_to_f32;
+    for (size_t i = 0; i < TENSOR_CAST_COUNT; i++) {
+        table->transpose_cast_block_edge[i] = 1;
+    }
+    table->quantize_row[0] = quantize_row_s8;
+    table->quantize_row[1] = quantize_row_u8;
+    table->dequantize_row[0] = dequantize_row_s8;
+    table->dequantize_row[1] = dequantize_row_u8;
+    table->normalize_pixels = normalize_pixels;
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t c = 0; c < 3; c++) {
+            table->deinterleave[i][c] = NULL;   // Scalar: tiled transpose is as fast
+            table->interleave[i][c] = NULL;
+        }
+    }
+#if TENSOR_HAVE_SSE2
+    if (isa >= TENSOR_ISA_SSE2) {
+        table->convert_row[TENSOR_CAST_F32_TO_F16] = convert_row_f32_to_f16_sse2;
+        table->convert_row[TENSOR_CAST_F16_TO_F32] = convert_row_f16_to_f32_sse2;
+        table->transpose_cast_block[TENSOR_CAST_F32_TO_F16] = transpose_block_f32_to_f16_sse2;
+        table->transpose_cast_block[TENSOR_CAST_F16_TO_F32] = transpose_block_f16_to_f32_sse2;
+        for (size_t i = 0; i < TENSOR_CAST_COUNT; i++) {
+            table->transpose_cast_block_edge[i] = 4;
+        }
+        table->quantize_row[0] = quantize_row_s8_sse2;
+        table->quantize_row[1] = quantize_row_u8_sse2;
+        table->dequantize_row[0] = dequantize_row_s8_sse2;
+        table->dequantize_row[1] = dequantize_row_u8_sse2;
+        table->deinterleave[0][0] = deinterleave_8_c2_sse2;
+        table->deinterleave[0][2] = deinterleave_8_c4_sse2;
+        table->deinterleave[1][0] = deinterleave_32_c2_sse2;
+        table->deinterleave[1][1] = deinterleave_32_c3_sse2;
+        table->deinterleave[1][2] = deinterleave_32_c4_sse2;
+        table->interleave[0][0] = interleave_8_c2_sse2;
+        table->interleave[0][2] = interleave_8_c4_sse2;
+        table->interleave[1][0] = interleave_32_c2_sse2;
+        table->interleave[1][1] = interleave_32_c3_sse2;
+        table->interleave[1][2] = interleave_32_c4_sse2;
+        table->transpose_block[0] = transpose_block_8_sse2;
+        table->transpose_block[1] = transpose_block_16_sse2;
+        table->transpose_block[2] = transpose_block_32_sse2;
+        for (size_t i = 0; i < 3; i++) {
+            table->transpose_block_edge[i] = 16 >> i;
+        }
+    }
+#endif
+#if TENSOR_HAVE_AVX2
+    if (isa >= TENSOR_ISA_AVX2) {
+        table->transpose_block[2] = transpose_block_32_avx2;
+        table->transpose_block_edge[2] = 8;
+        table->quantize_row[0] = quantize_row_s8_avx2;
+        table->quantize_row[1] = quantize_row_u8_avx2;
+        table->dequantize_row[0] = dequantize_row_s8_avx2;
+        table->dequantize_row[1] = dequantize_row_u8_avx2;
+        table->normalize_pixels = normalize_pixels_avx2;
+        table->deinterleave[0][1] = deinterleave_8_c3_avx2;
+        table->interleave[0][1] = interleave_8_c3_avx2;
+    }
+#endif
+#if TENSOR_HAVE_F16C
+    if (isa >= TENSOR_ISA_AVX2 && detect_cpu_f16c()) {
+        table->convert_row[TENSOR_CAST_F32_TO_F16] = convert_row_f32_to_f16_f16c;
+        table->convert_row[TENSOR_CAST_F16_TO_F32] = convert_row_f16_to_f32_f16c;
+        table->transpose_cast_block[TENSOR_CAST_F32_TO_F16] = transpose_block_f32_to_f16_f16c;
+        table->transpose_cast_block[TENSOR_CAST_F16_TO_F32] = transpose_block_f16_to_f32_f16c;
+        for (size_t i = 0; i < TENSOR_CAST_COUNT; i++) {
+            table->transpose_cast_block_edge[i] = 8;
+        }
+    }
+#endif
+#if TENSOR_HAVE_AVX512
+    if (isa >= TENSOR_ISA_AVX512) {
+        table->transpose_block[0] = transpose_block_8_avx512;
+        table->transpose_block[1] = transpose_block_16_avx512;
+        table->transpose_block[2] = transpose_block_32_avx512;
+        table->transpose_block[3] = transpose_block_64_avx512;
+        for (size_t i = 0; i < 4; i++) {
+            table->transpose_block_edge[i] = 64 >> i;
+        }
+    }
+#endif
+}
+
+/**
+ * Storage of the process-wide kernel table
+ */
+static inline tensor_kernel_table_t* get_kernel_table_storage(void) {
+    static tensor_kernel_table_t table;
+    return &table;
+}
+
+/**
+ * Build the kernel table for the running CPU
+ * The TENSOR_CONVERTER_ISA environment variable (scalar, sse2, avx2, avx512)
+ * forces a lower ISA for testing; requests above what the CPU supports are
+ * clamped to the detected level.
+ */
+static inline void build_kernel_table(void) {
+    tensor_isa_t isa = detect_cpu_isa();
+    const char* forced = getenv("TENSOR_CONVERTER_ISA");
+    if (forced) {
+        for (int level = TENSOR_ISA_SCALAR; level <= TENSOR_ISA_AVX512; level++) {
+            if (strcmp(forced, get_isa_name((tensor_isa_t)level)) == 0) {
+                if ((tensor_isa_t)level < isa) {
+                    isa = (tensor_isa_t)level;
+                }
+                break;
+            }
+        }
+    }
+    init_kernel_table(get_kernel_table_storage(), isa);
+}
+
+/**
+ * Get the kernel table for the running CPU
+ * The table is built once on first use; concurrent first callers wait for it.
+ * @return Kernel table
+ */
+static inline const tensor_kernel_table_t* get_kernel_table(void) {
+#if defined(__GNUC__) || defined(__clang__)
+    static int state = 0; // 0: empty, 1: building, 2: ready
+    if (__atomic_load_n(&state, __ATOMIC_ACQUIRE) != 2) {
+        int expected = 0;
+        if (__atomic_compare_exchange_n(&state, &expected, 1, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            build_kernel_table();
+            __atomic_store_n(&state, 2, __ATOMIC_RELEASE);
+        } else {
+            while (__atomic_load_n(&state, __ATOMIC_ACQUIRE) != 2) {
+            }
+        }
+    }
+#elif defined(TENSOR_CONVERTER_ENABLE_THREADS)
+    static pthread_once_t once = PTHREAD_ONCE_INIT;
+    pthread_once(&once, build_kernel_table);
+#else
+    static volatile bool initialized = false;
+    if (!initialized) {
+        build_kernel_table();
+        initialized = true;
+    }
+#endif
+    return get_kernel_table_storage();
+}
+
+/**
+ * Index of a 1/2/4/8-byte element size in the kernel table
+ * @param element_size Single element byte size
+ * @return Table index, or -1 if no specialized kernel exists
+ */
+static inline int get_kernel_index(size_t element_size) {
+    switch (element_size) {
+        case 1:
+            return 0;
+        case 2:
+            return 1;
+        case 4:
+            return 2;
+        case 8:
+            return 3;
+        default:
+            return -1;
+    }
+}
+
+/**
+ * Select the transpose block kernel for an element size
+ * @param element_size Single element byte size
+ * @return Block kernel, or NULL if no specialized kernel exists
+ */
+static inline transpose_block_fn get_transpose_block_kernel(size_t element_size) {
+    int index = get_kernel_index(element_size);
+    return index < 0 ? NULL : get_kernel_table()->transpose_block[index];
+}
+
+/**
+ * Register block edge of the selected transpose kernel
+ * Tile edges are rounded up to a multiple of it so that full tiles never
+ * fall onto the scalar edge path.
+ * @param element_size Single element byte size
+ * @return Edge in elements (1 for scalar kernels)
+ */
+static inline size_t get_transpose_block_edge(size_t element_size) {
+    int index = get_kernel_index(element_size);
+    return index < 0 ? 1 : get_kernel_table()->transpose_block_edge[index];
+}
+
+/**
+ * Tile edge used with the selected block kernel
+ * Rounded up to a multiple of the kernel's register block edge so that full
+ * tiles never fall onto the scalar edge path.
+ * @param element_size Single element byte size
+ * @param tile Requested tile edge in elements, 0 for TENSOR_CONVERTER_TILE_SIZE
+ * @return Tile edge in elements
+ */
+static inline size_t get_transpose_tile(size_t element_size, size_t tile) {
+    size_t block_edge = get_transpose_block_edge(element_size);
+    if (tile == 0) {
+        tile = TENSOR_CONVERTER_TILE_SIZE;
+    }
+    return (tile + block_edge - 1) / block_edge * block_edge;
+}
+
+/**
+ * Cache-blocked 2D transpose with a preselected block kernel
+ * Source and destination element sizes differ for the fused conversion
+ * kernels; the generic byte-copy path requires them to match.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param rows Number of source rows
+ * @param cols Number of source columns
+ * @param src_stride Distance between consecutive source rows (elements)
+ * @param dst_stride Distance between consecutive destination rows (elements)
+ * @param src_element_size Source element byte size
+ * @param dst_element_size Destination element byte size
+ * @param kernel Block kernel, NULL for the generic byte-copy path
+ * @param tile Tile edge in elements (see get_transpose_tile)
+ */
+static inline void transpose_2d_blocked_cast(const void* src, void* dst,
+                                             size_t rows, size_t cols,
+                                             size_t src_stride, size_t dst_stride,
+                                             size_t src_element_size, size_t dst_element_size,
+                                             transpose_block_fn kernel, size_t tile) {
+    const char* src_data = (const char*)src;
+    char* dst_data = (char*)dst;
+
+    for (size_t r0 = 0; r0 < rows; r0 += tile) {
+        size_t block_rows = (rows - r0 < tile) ? rows - r0 : tile;
+        for (size_t c0 = 0; c0 < cols; c0 += tile) {
+            size_t block_cols = (cols - c0 < tile) ? cols - c0 : tile;
+            const char* src_block = src_data + (r0 * src_stride + c0) * src_element_size;
+            char* dst_block = dst_data + (c0 * dst_stride + r0) * dst_element_size;
+
+            if (kernel) {
+                kernel(src_block, src_stride, dst_block, dst_stride, block_rows, block_cols);
+                continue;
+            }
+
+            // Generic element size: byte copy per element
+            for (size_t c = 0; c < block_cols; c++) {
+                const char* src_ptr = src_block + c * src_element_size;
+                char* dst_ptr = dst_block + c * dst_stride * dst_element_size;
+                for (size_t r = 0; r < block_rows; r++) {
+                    memcpy(dst_ptr, src_ptr, src_element_size);
+                    src_ptr += src_stride * src_element_size;
+                    dst_ptr += dst_element_size;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Cache-blocked 2D transpose with a preselected block kernel
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param rows Number of source rows
+ * @param cols Number of source columns
+ * @param src_stride Distance between consecutive source rows (elements)
+ * @param dst_stride Distance between consecutive destination rows (elements)
+ * @param element_size Single element byte size
+ * @param kernel Block kernel, NULL for the generic byte-copy path
+ * @param tile Tile edge in elements (see get_transpose_tile)
+ */
+static inline void transpose_2d_blocked(const void* src, void* dst,
+                                        size_t rows, size_t cols,
+                                        size_t src_stride, size_t dst_stride,
+                                        size_t element_size,
+                                        transpose_block_fn kernel, size_t tile) {
+    transpose_2d_blocked_cast(src, dst, rows, cols, src_stride, dst_stride,
+                              element_size, element_size, kernel, tile);
+}
+
+/**
+ * Cache-blocked 2D transpose: dst[c][r] = src[r][c]
+ * The matrix is walked in tile x tile blocks so that both the read and the
+ * write side stay within a small set of cache lines and pages per block.
+ * The block kernel is chosen once per call from the element size.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param rows Number of source rows
+ * @param cols Number of source columns
+ * @param src_stride Distance between consecutive source rows (elements)
+ * @param dst_stride Distance between consecutive destination rows (elements)
+ * @param element_size Single element byte size
+ * @param tile Tile edge in elements
+ */
+static inline void transpose_2d_tiled(const void* src, void* dst,
+                                      size_t rows, size_t cols,
+                                      size_t src_stride, size_t dst_stride,
+                                      size_t element_size, size_t tile) {
+    transpose_2d_blocked(src, dst, rows, cols, src_stride, dst_stride, element_size,
+                         get_transpose_block_kernel(element_size),
+                         get_transpose_tile(element_size, tile));
+}
+
+/**
+ * Parallel task: processes work items [begin, end)
+ */
+typedef void (*tensor_task_fn)(void* ctx, size_t begin, size_t end);
+
+#if defined(TENSOR_CONVERTER_ENABLE_THREADS)
+/**
+ * Persistent worker pool
+ * Workers sleep on a condition variable between jobs. A job is split into
+ * num_workers + 1 contiguous item ranges, the calling thread runs range 0.
+ */
+typedef struct {
+    pthread_t* threads;         // Worker threads
+    size_t num_workers;         // Number of worker threads (caller excluded)
+    pthread_mutex_t mutex;      // Protects the job fields below
+    pthread_cond_t work_cond;   // Signals a new job or shutdown
+    pthread_cond_t done_cond;   // Signals job completion
+    pthread_mutex_t run_mutex;  // Serializes jobs from concurrent callers
+    tensor_task_fn fn;          // Current job
+    void* ctx;                  // Current job context
+    size_t num_items;           // Current job item count
+    size_t num_parts;           // Participants of the current job, caller included
+    size_t pending;             // Workers still running the current job
+    unsigned long generation;   // Incremented per job
+    bool shutdown;              // Workers exit when set
+} tensor_thread_pool_t;
+
+/**
+ * Item range of one participant in a job
+ */
+static inline void get_task_range(size_t num_items, size_t num_parts, size_t part,
+                                  size_t* begin, size_t* end) {
+    size_t base = num_items / num_parts;
+    size_t extra = num_items % num_parts;
+    *begin = part * base + (part < extra ? part : extra);
+    *end = *begin + base + (part < extra ? 1 : 0);
+}
+
+typedef struct {
+    tensor_thread_pool_t* pool;
+    size_t index;   // Participant index, 1..num_workers
+} tensor_worker_arg_t;
+
+static inline void* thread_pool_worker(void* arg) {
+    tensor_worker_arg_t* worker = (tensor_worker_arg_t*)arg;
+    tensor_thread_pool_t* pool = worker->pool;
+    size_t index = worker->index;
+    unsigned long seen = 0;
+    free(worker);
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;) {
+        while (!pool->shutdown && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_cond, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        tensor_task_fn fn = pool->fn;
+        void* ctx = pool->ctx;
+        size_t begin = 0, end = 0;
+        if (index < pool->num_parts) {
+            get_task_range(pool->num_items, pool->num_parts, index, &begin, &end);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+
+        if (begin < end) {
+            fn(ctx, begin, end);
+        }
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0) {
+            pthread_cond_signal(&pool->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+/**
+ * Stop and free a worker pool
+ * @param pool Pool pointer, may be NULL
+ */
+static inline void thread_pool_destroy(tensor_thread_pool_t* pool) {
+    if (!pool) {
+        return;
+    }
+    pthread_mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work_cond);
+    pthread_mutex_unlock(&pool->mutex);
+    for (size_t i = 0; i < pool->num_workers; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->run_mutex);
+    pthread_cond_destroy(&pool->work_cond);
+    pthread_cond_destroy(&pool->done_cond);
+    free(pool->threads);
+    free(pool);
+}
+
+/**
+ * Create a worker pool
+ * @param num_workers Number of worker threads (the caller is an extra participant)
+ * @return Pool pointer, NULL on failure
+ */
+static inline tensor_thread_pool_t* thread_pool_create(size_t num_workers) {
+    if (num_workers == 0) {
+        return NULL;
+    }
+    tensor_thread_pool_t* pool = (tensor_thread_pool_t*)calloc(1, sizeof(tensor_thread_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+    pool->threads = (pthread_t*)calloc(num_workers, sizeof(pthread_t));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_mutex_init(&pool->run_mutex, NULL);
+    pthread_cond_init(&pool->work_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    for (size_t i = 0; i < num_workers; i++) {
+        tensor_worker_arg_t* arg = (tensor_worker_arg_t*)malloc(sizeof(tensor_worker_arg_t));
+        if (!arg) {
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        arg->pool = pool;
+        arg->index = i + 1;
+        if (pthread_create(&pool->threads[i], NULL, thread_pool_worker, arg) != 0) {
+            free(arg);
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->num_workers++;
+    }
+    return pool;
+}
+
+/**
+ * Get the process-wide pool slot
+ * Like every other function in this header the slot is per translation unit.
+ */
+static inline tensor_thread_pool_t** get_thread_pool_slot(void) {
+    static tensor_thread_pool_t* pool = NULL;
+    return &pool;
+}
+#endif // TENSOR_CONVERTER_ENABLE_THREADS
+
+/**
+ * Set the number of threads used by the layout converters
+ * The pool is created once here and reused by every later conversion.
+ * Requires TENSOR_CONVERTER_ENABLE_THREADS (POSIX threads); must not be
+ * called while conversions are running.
+ * @param num_threads Total threads including the caller, 0 or 1 disables the pool
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool tensor_converter_set_num_threads(size_t num_threads) {
+#if defined(TENSOR_CONVERTER_ENABLE_THREADS)
+    tensor_thread_pool_t** slot = get_thread_pool_slot();
+    thread_pool_destroy(*slot);
+    *slot = NULL;
+    if (num_threads <= 1) {
+        return true;
+    }
+    *slot = thread_pool_create(num_threads - 1);
+    return *slot != NULL;
+#else
+    return num_threads <= 1;
+#endif
+}
+
+/**
+ * Get the number of threads used by the layout converters
+ * @return Total threads including the caller (1 when the pool is disabled)
+ */
+static inline size_t tensor_converter_get_num_threads(void) {
+#if defined(TENSOR_CONVERTER_ENABLE_THREADS)
+    tensor_thread_pool_t* pool = *get_thread_pool_slot();
+    return pool ? pool->num_workers + 1 : 1;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Run a task over num_items items on the worker pool
+ * Runs on the calling thread when the pool is disabled, when there is
+ * only one item, or when another thread is already using the pool.
+ * @param fn Task function
+ * @param ctx Task context
+ * @param num_items Number of work items
+ * @param max_parts Upper bound on participating threads (grain-size limit)
+ */
+static inline void parallel_for(tensor_task_fn fn, void* ctx, size_t num_items, size_t max_parts) {
+#if defined(TENSOR_CONVERTER_ENABLE_THREADS)
+    tensor_thread_pool_t* pool = *get_thread_pool_slot();
+    if (pool && num_items > 1 && max_parts > 1 &&
+        pthread_mutex_trylock(&pool->run_mutex) == 0) {
+        size_t num_parts = pool->num_workers + 1;
+        if (num_parts > max_parts) {
+            num_parts = max_parts;
+        }
+        if (num_parts > num_items) {
+            num_parts = num_items;
+        }
+        size_t begin, end;
+        pthread_mutex_lock(&pool->mutex);
+        pool->fn = fn;
+        pool->ctx = ctx;
+        pool->num_items = num_items;
+        pool->num_parts = num_parts;
+        pool->pending = pool->num_workers;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->work_cond);
+        pthread_mutex_unlock(&pool->mutex);
+
+        get_task_range(num_items, num_parts, 0, &begin, &end);
+        fn(ctx, begin, end);
+
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->pending > 0) {
+            pthread_cond_wait(&pool->done_cond, &pool->mutex);
+        }
+        pthread_mutex_unlock(&pool->mutex);
+        pthread_mutex_unlock(&pool->run_mutex);
+        return;
+    }
+#endif
+    (void)max_parts;
+    fn(ctx, 0, num_items);
+}
+
+/**
+ * Batched transpose task context
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t rows;              // Source rows per batch item
+    size_t cols;              // Source columns per batch item
+    size_t src_element_size;
+    size_t dst_element_size;
+    transpose_block_fn kernel; // Block kernel (NULL for generic element sizes)
+    size_t tile;              // Tile edge in elements
+    bool split_rows;          // Work items split rows (else columns)
+    size_t chunk;             // Rows or columns per work item
+    size_t chunks_per_batch;  // Work items per batch item
+} batched_transpose_ctx_t;
+
+static inline void batched_transpose_task(void* arg, size_t begin, size_t end) {
+    const batched_transpose_ctx_t* ctx = (const batched_transpose_ctx_t*)arg;
+    size_t src_element_size = ctx->src_element_size;
+    size_t dst_element_size = ctx->dst_element_size;
+    size_t src_batch_bytes = ctx->rows * ctx->cols * src_element_size;
+    size_t dst_batch_bytes = ctx->rows * ctx->cols * dst_element_size;
+    size_t extent = ctx->split_rows ? ctx->rows : ctx->cols;
+
+    for (size_t item = begin; item < end; item++) {
+        size_t n = item / ctx->chunks_per_batch;
+        size_t start = (item % ctx->chunks_per_batch) * ctx->chunk;
+        size_t count = (extent - start < ctx->chunk) ? extent - start : ctx->chunk;
+        const char* src_batch = ctx->src + n * src_batch_bytes;
+        char* dst_batch = ctx->dst + n * dst_batch_bytes;
+        if (ctx->split_rows) {
+            transpose_2d_blocked_cast(src_batch + start * ctx->cols * src_element_size,
+                                      dst_batch + start * dst_element_size,
+                                      count, ctx->cols, ctx->cols, ctx->rows,
+                                      src_element_size, dst_element_size,
+                                      ctx->kernel, ctx->tile);
+        } else {
+            transpose_2d_blocked_cast(src_batch + start * src_element_size,
+                                      dst_batch + start * ctx->rows * dst_element_size,
+                                      ctx->rows, count, ctx->cols, ctx->rows,
+                                      src_element_size, dst_element_size,
+                                      ctx->kernel, ctx->tile);
+        }
+    }
+}
+
+/**
+ * Channel shuffle task context
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t pixels;              // Pixels per batch item
+    size_t channels;
+    size_t element_size;
+    bool deinterleave;          // HWC -> CHW (else CHW -> HWC)
+    size_t chunk;               // Pixels per work item
+    size_t chunks_per_batch;    // Work items per batch item
+    channel_shuffle_fn kernel;
+} channel_shuffle_ctx_t;
+
+static inline void channel_shuffle_task(void* arg, size_t begin, size_t end) {
+    const channel_shuffle_ctx_t* ctx = (const channel_shuffle_ctx_t*)arg;
+    size_t batch_bytes = ctx->pixels * ctx->channels * ctx->element_size;
+    size_t interleaved_offset = ctx->channels * ctx->element_size;
+    for (size_t item = begin; item < end; item++) {
+        size_t n = item / ctx->chunks_per_batch;
+        size_t start = (item % ctx->chunks_per_batch) * ctx->chunk;
+        size_t count = (ctx->pixels - start < ctx->chunk) ? ctx->pixels - start : ctx->chunk;
+        const char* src_batch = ctx->src + n * batch_bytes;
+        char* dst_batch = ctx->dst + n * batch_bytes;
+        if (ctx->deinterleave) {
+            ctx->kernel(src_batch + start * interleaved_offset,
+                        dst_batch + start * ctx->element_size, count, ctx->pixels);
+        } else {
+            ctx->kernel(src_batch + start * ctx->element_size,
+                        dst_batch + start * interleaved_offset, count, ctx->pixels);
+        }
+    }
+}
+
+/**
+ * Transpose a batch of matrices with 2-4 rows or columns by channel shuffles
+ * Such matrices are the HWC <-> CHW permutations of RGB(A)-style tensors,
+ * where tiles would be mostly empty. Handles 1 and 4-byte elements when the
+ * selected ISA has a kernel for the channel count.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param batch Number of matrices
+ * @param rows Number of source rows per matrix
+ * @param cols Number of source columns per matrix
+ * @param element_size Single element byte size
+ * @return Returns true if handled, false if the shape or element size does not apply
+ */
+static inline bool transpose_batched_channels(const void* src, void* dst, size_t batch,
+                                              size_t rows, size_t cols, size_t element_size) {
+    channel_shuffle_ctx_t ctx;
+    const tensor_kernel_table_t* table = get_kernel_table();
+    size_t type_index = element_size == 1 ? 0 : 1;
+
+    if (element_size != 1 && element_size != 4) {
+        return false;
+    }
+    if (cols >= 2 && cols <= 4) {
+        ctx.deinterleave = true;
+        ctx.pixels = rows;
+        ctx.channels = cols;
+        ctx.kernel = table->deinterleave[type_index][cols - 2];
+    } else if (rows >= 2 && rows <= 4) {
+        ctx.deinterleave = false;
+        ctx.pixels = cols;
+        ctx.channels = rows;
+        ctx.kernel = table->interleave[type_index][rows - 2];
+    } else {
+        return false;
+    }
+    if (!ctx.kernel) {
+        return false;
+    }
+
+    size_t total_bytes = batch * rows * cols * element_size;
+    ctx.src = (const char*)src;
+    ctx.dst = (char*)dst;
+    ctx.element_size = element_size;
+    // Work items of about one grain, rounded to the 16-pixel SIMD step
+    ctx.chunk = (TENSOR_CONVERTER_PARALLEL_GRAIN / (ctx.channels * element_size) + 15) / 16 * 16;
+    if (ctx.chunk > ctx.pixels) {
+        ctx.chunk = ctx.pixels;
+    }
+    ctx.chunks_per_batch = (ctx.pixels + ctx.chunk - 1) / ctx.chunk;
+    parallel_for(channel_shuffle_task, &ctx, batch * ctx.chunks_per_batch,
+                 total_bytes / TENSOR_CONVERTER_PARALLEL_GRAIN);
+    return true;
+}
+
+/**
+ * Transpose a batch of rows x cols matrices, converting element types
+ * Matrices with 2-4 rows or columns go to the channel shuffle kernels.
+ * Otherwise work is split across batch items and along the longer matrix axis in
+ * tile-aligned chunks; tensors below TENSOR_CONVERTER_PARALLEL_GRAIN bytes
+ * per thread stay on the calling thread.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param batch Number of matrices
+ * @param rows Number of source rows per matrix
+ * @param cols Number of source columns per matrix
+ * @param src_element_size Source element byte size
+ * @param dst_element_size Destination element byte size
+ * @param kernel Block kernel, NULL for the generic byte-copy path (equal sizes only)
+ * @param tile Tile edge in elements
+ */
+static inline void transpose_batched_cast(const void* src, void* dst, size_t batch,
+                                          size_t rows, size_t cols,
+                                          size_t src_element_size, size_t dst_element_size,
+                                          transpose_block_fn kernel, size_t tile) {
+    if (src_element_size == dst_element_size &&
+        transpose_batched_channels(src, dst, batch, rows, cols, src_element_size)) {
+        return;
+    }
+
+    size_t num_threads = tensor_converter_get_num_threads();
+    size_t max_element_size = src_element_size > dst_element_size ? src_element_size
+                                                                   : dst_element_size;
+    size_t total_bytes = batch * rows * cols * max_element_size;
+    size_t max_parts = total_bytes / TENSOR_CONVERTER_PARALLEL_GRAIN;
+
+    batched_transpose_ctx_t ctx;
+    ctx.src = (const char*)src;
+    ctx.dst = (char*)dst;
+    ctx.rows = rows;
+    ctx.cols = cols;
+    ctx.src_element_size = src_element_size;
+    ctx.dst_element_size = dst_element_size;
+    ctx.kernel = kernel;
+    ctx.tile = tile;
+    ctx.split_rows = rows >= cols;
+    ctx.chunk = ctx.split_rows ? rows : cols;
+    ctx.chunks_per_batch = 1;
+
+    if (num_threads > 1 && max_parts > 1) {
+        // About four items per thread for load balance, each at least a 64-element strip
+        size_t extent = ctx.chunk;
+        size_t target_items = num_threads * 4;
+        size_t per_batch = (target_items + batch - 1) / batch;
+        size_t chunk = (extent + per_batch - 1) / per_batch;
+        chunk = (chunk + 63) / 64 * 64;
+        ctx.chunk = chunk < extent ? chunk : extent;
+        ctx.chunks_per_batch = (extent + ctx.chunk - 1) / ctx.chunk;
+    }
+    parallel_for(batched_transpose_task, &ctx, batch * ctx.chunks_per_batch, max_parts);
+}
+
+/**
+ * Transpose a batch of rows x cols matrices with a preselected kernel
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param batch Number of matrices
+ * @param rows Number of source rows per matrix
+ * @param cols Number of source columns per matrix
+ * @param element_size Single element byte size
+ * @param kernel Block kernel, NULL for the generic byte-copy path
+ * @param tile Tile edge in elements (see get_transpose_tile)
+ */
+static inline void transpose_batched_with(const void* src, void* dst, size_t batch,
+                                          size_t rows, size_t cols, size_t element_size,
+                                          transpose_block_fn kernel, size_t tile) {
+    transpose_batched_cast(src, dst, batch, rows, cols, element_size, element_size,
+                           kernel, tile);
+}
+
+/**
+ * Transpose a batch of rows x cols matrices
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param batch Number of matrices
+ * @param rows Number of source rows per matrix
+ * @param cols Number of source columns per matrix
+ * @param element_size Single element byte size
+ */
+static inline void transpose_batched(const void* src, void* dst, size_t batch,
+                                     size_t rows, size_t cols, size_t element_size) {
+    transpose_batched_with(src, dst, batch, rows, cols, element_size,
+                           get_transpose_block_kernel(element_size),
+                           get_transpose_tile(element_size, 0));
+}
+
+/**
+ * N-d transpose task context
+ * Each work item is one position of the outer axes: either a contiguous run
+ * (innermost axis unmoved) or a 2D transpose of the two innermost moving axes.
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t num_outer;                           // Number of outer axes
+    size_t outer_dims[TENSOR_MAX_DIMS];         // Outer extents, destination order
+    size_t outer_src_strides[TENSOR_MAX_DIMS];  // Outer source strides (bytes)
+    size_t outer_dst_strides[TENSOR_MAX_DIMS];  // Outer destination strides (bytes)
+    size_t run_bytes;                           // Contiguous copy per item, 0 to transpose
+    size_t rows;                                // Inner transpose: source rows
+    size_t cols;                                // Inner transpose: source columns
+    size_t src_stride;                          // Inner transpose: source row stride (elements)
+    size_t dst_stride;                          // Inner transpose: destination row stride (elements)
+    size_t element_size;
+    transpose_block_fn kernel;                  // Block kernel (NULL for generic element sizes)
+    size_t tile;                                // Tile edge in elements
+} tensor_transpose_ctx_t;
+
+static inline void tensor_transpose_task(void* arg, size_t begin, size_t end) {
+    const tensor_transpose_ctx_t* ctx = (const tensor_transpose_ctx_t*)arg;
+    size_t index[TENSOR_MAX_DIMS];
+    size_t src_offset = 0;
+    size_t dst_offset = 0;
+    size_t rem = begin;
+
+    for (size_t i = ctx->num_outer; i-- > 0;) {
+        index[i] = rem % ctx->outer_dims[i];
+        rem /= ctx->outer_dims[i];
+        src_offset += index[i] * ctx->outer_src_strides[i];
+        dst_offset += index[i] * ctx->outer_dst_strides[i];
+    }
+
+    for (size_t item = begin; item < end; item++) {
+        if (ctx->run_bytes) {
+            memcpy(ctx->dst + dst_offset, ctx->src + src_offset, ctx->run_bytes);
+        } else {
+            transpose_2d_blocked(ctx->src + src_offset, ctx->dst + dst_offset,
+                                 ctx->rows, ctx->cols, ctx->src_stride, ctx->dst_stride,
+                                 ctx->element_size, ctx->kernel, ctx->tile);
+        }
+
+        // Advance the outer index, innermost outer axis first
+        for (size_t i = ctx->num_outer; i-- > 0;) {
+            src_offset += ctx->outer_src_strides[i];
+            dst_offset += ctx->outer_dst_strides[i];
+            if (++index[i] < ctx->outer_dims[i]) {
+                break;
+            }
+            src_offset -= ctx->outer_src_strides[i] * ctx->outer_dims[i];
+            dst_offset -= ctx->outer_dst_strides[i] * ctx->outer_dims[i];
+            index[i] = 0;
+        }
+    }
+}
+
+/**
+ * Simplify a transpose shape
+ * Drops size-1 axes and merges runs of source axes that stay adjacent and in
+ * order after the permutation. [N,C,H,W] -> [N,H,W,C] becomes [N,C,H*W] with
+ * perm {0,2,1}; 1xCx1x1 and other order-preserving shapes become one axis.
+ * @param dims Source extents
+ * @param num_dims Number of dimensions (at most TENSOR_MAX_DIMS)
+ * @param perm Axis permutation: destination axis i is source axis perm[i]
+ * @param out_dims Output: simplified source extents
+ * @param out_perm Output: simplified permutation
+ * @return Number of simplified dimensions, 0 when every extent is 1
+ */
+static inline size_t simplify_transpose_shape(const size_t* dims, size_t num_dims,
+                                              const size_t* perm,
+                                              size_t* out_dims, size_t* out_perm) {
+    size_t axis_map[TENSOR_MAX_DIMS];
+    size_t kept_perm[TENSOR_MAX_DIMS];
+    size_t kept_dims[TENSOR_MAX_DIMS];
+    size_t num_kept = 0;
+
+    // Renumber the source axes that are not size 1
+    for (size_t i = 0; i < num_dims; i++) {
+        if (dims[i] > 1) {
+            kept_dims[num_kept] = dims[i];
+            axis_map[i] = num_kept++;
+        }
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < num_dims; i++) {
+        if (dims[perm[i]] > 1) {
+            kept_perm[n++] = axis_map[perm[i]];
+        }
+    }
+
+    // Group destination-order runs of consecutive source axes
+    size_t group_start[TENSOR_MAX_DIMS];
+    size_t group_extent[TENSOR_MAX_DIMS];
+    size_t num_groups = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (num_groups > 0 && kept_perm[i] == kept_perm[i - 1] + 1) {
+            group_extent[num_groups - 1] *= kept_dims[kept_perm[i]];
+        } else {
+            group_start[num_groups] = kept_perm[i];
+            group_extent[num_groups] = kept_dims[kept_perm[i]];
+            num_groups++;
+        }
+    }
+
+    // A group's new source axis is its rank by starting source axis
+    for (size_t g = 0; g < num_groups; g++) {
+        size_t rank = 0;
+        for (size_t h = 0; h < num_groups; h++) {
+            if (group_start[h] < group_start[g]) {
+                rank++;
+            }
+        }
+        out_perm[g] = rank;
+        out_dims[rank] = group_extent[g];
+    }
+    return num_groups;
+}
+
+/**
+ * Generic N-d transpose of a simplified shape
+ * When the innermost axis stays in place each outer position is one
+ * contiguous copy. Otherwise the source innermost axis and the axis that
+ * becomes the destination innermost form a 2D transpose that runs through
+ * the same tiled/SIMD block kernels as the layout conversions; the
+ * remaining axes are walked in destination order and split across the
+ * worker pool when one is configured.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param dims Source extents
+ * @param num_dims Number of dimensions (1 to TENSOR_MAX_DIMS)
+ * @param perm Axis permutation
+ * @param element_size Single element byte size
+ */
+static inline void transpose_tensor_general(const void* src, void* dst,
+                                            const size_t* dims, size_t num_dims,
+                                            const size_t* perm, size_t element_size) {
+    // Element strides of the source axes and of the destination axes
+    size_t src_strides[TENSOR_MAX_DIMS];
+    size_t dst_strides[TENSOR_MAX_DIMS];
+    size_t src_step = 1;
+    size_t dst_step = 1;
+    for (size_t i = num_dims; i-- > 0;) {
+        src_strides[i] = src_step;
+        src_step *= dims[i];
+        dst_strides[i] = dst_step;
+        dst_step *= dims[perm[i]];
+    }
+
+    size_t last = num_dims - 1;
+    size_t inner_src_axis = perm[last];  // Source axis that becomes contiguous in dst
+    size_t inner_dst_axis = 0;           // Destination axis holding the source innermost axis
+    for (size_t i = 0; i < num_dims; i++) {
+        if (perm[i] == last) {
+            inner_dst_axis = i;
+        }
+    }
+
+    tensor_transpose_ctx_t ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.src = (const char*)src;
+    ctx.dst = (char*)dst;
+    ctx.element_size = element_size;
+
+    size_t num_items = 1;
+    for (size_t i = 0; i < num_dims; i++) {
+        if (i == last || (inner_src_axis != last && i == inner_dst_axis)) {
+            continue;
+        }
+        ctx.outer_dims[ctx.num_outer] = dims[perm[i]];
+        ctx.outer_src_strides[ctx.num_outer] = src_strides[perm[i]] * element_size;
+        ctx.outer_dst_strides[ctx.num_outer] = dst_strides[i] * element_size;
+        num_items *= dims[perm[i]];
+        ctx.num_outer++;
+    }
+
+    if (inner_src_axis == last) {
+        ctx.run_bytes = dims[last] * element_size;
+    } else {
+        ctx.rows = dims[inner_src_axis];
+        ctx.cols = dims[last];
+        ctx.src_stride = src_strides[inner_src_axis];
+        ctx.dst_stride = dst_strides[inner_dst_axis];
+        ctx.kernel = get_transpose_block_kernel(element_size);
+        ctx.tile = get_transpose_tile(element_size, 0);
+    }
+
+    parallel_for(tensor_transpose_task, &ctx, num_items,
+                 src_step * element_size / TENSOR_CONVERTER_PARALLEL_GRAIN);
+}
+
+/**
+ * Transpose without argument validation
+ * Simplifies the shape first, then dispatches to memcpy (order-preserving
+ * permutations), the batched 2D transpose ([B,R,C] -> [B,C,R]) or the
+ * general engine.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param dims Source extents, all positive
+ * @param num_dims Number of dimensions (1 to TENSOR_MAX_DIMS)
+ * @param perm Valid axis permutation
+ * @param element_size Single element byte size
+ */
+static inline void transpose_tensor_unchecked(const void* src, void* dst,
+                                              const size_t* dims, size_t num_dims,
+                                              const size_t* perm, size_t element_size) {
+    size_t simple_dims[TENSOR_MAX_DIMS];
+    size_t simple_perm[TENSOR_MAX_DIMS];
+    size_t n = simplify_transpose_shape(dims, num_dims, perm, simple_dims, simple_perm);
+
+    if (n <= 1) {
+        size_t total_bytes = element_size;
+        for (size_t i = 0; i < num_dims; i++) {
+            total_bytes *= dims[i];
+        }
+        memcpy(dst, src, total_bytes);
+    } else if (n == 2) {
+        transpose_batched(src, dst, 1, simple_dims[0], simple_dims[1], element_size);
+    } else if (n == 3 && simple_perm[0] == 0 && simple_perm[1] == 2) {
+        transpose_batched(src, dst, simple_dims[0], simple_dims[1], simple_dims[2],
+                          element_size);
+    } else {
+        transpose_tensor_general(src, dst, simple_dims, n, simple_perm, element_size);
+    }
+}
+
+/**
+ * Generic N-d transpose: destination axis i is source axis perm[i]
+ * Size-1 axes and axes that stay adjacent are merged first, so degenerate
+ * permutations run at memcpy speed and layout-style permutations use the
+ * batched 2D transpose.
+ * @param src Source data pointer
+ * @param dst Destination data pointer (must not overlap src)
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions (at most TENSOR_MAX_DIMS)
+ * @param perm Axis permutation of 0..num_dims-1
+ * @param element_size Single element byte size
+ * @return Whether the transpose was successful
+ */
+static inline bool transpose_tensor(const void* src, void* dst,
+                                    const int32_t* dims, size_t num_dims,
+                                    const size_t* perm, size_t element_size) {
+    if (!src || !dst || !perm || element_size == 0 || !validate_tensor_shape(dims, num_dims)) {
+        return false;
+    }
+
+    // perm must name every source axis exactly once
+    bool seen[TENSOR_MAX_DIMS] = {false};
+    for (size_t i = 0; i < num_dims; i++) {
+        if (perm[i] >= num_dims || seen[perm[i]]) {
+            return false;
+        }
+        seen[perm[i]] = true;
+    }
+
+    size_t total_elements = calculate_total_elements(dims, num_dims);
+    if (total_elements == 0 || !validate_memory_boundaries(src, dst, total_elements, element_size)) {
+        return false;
+    }
+
+    size_t extents[TENSOR_MAX_DIMS];
+    for (size_t i = 0; i < num_dims; i++) {
+        extents[i] = (size_t)dims[i];
+    }
+    transpose_tensor_unchecked(src, dst, extents, num_dims, perm, element_size);
+    return true;
+}
+
+/**
+ * NCHW to NHWC layout conversion
+ * Each batch item is a C x (H*W) matrix transposed into (H*W) x C,
+ * split across the worker pool when one is configured.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param N Batch size
+ * @param C Number of channels
+ * @param H Height
+ * @param W Width
+ * @param element_size Single element byte size
+ * @return Whether conversion was successful
+ */
+static inline bool convert_nchw_to_nhwc(const void* src, void* dst,
+                         int32_t N, int32_t C, int32_t H, int32_t W,
+                         size_t element_size) {
+    if (!src || !dst || N <= 0 || C <= 0 || H <= 0 || W <= 0 || element_size == 0) {
+        return false;
+    }
+
+    // Check for potential overflow in index calculations
+    if ((size_t)N > SIZE_MAX / (size_t)C / (size_t)H / (size_t)W ||
+        (size_t)C > SIZE_MAX / (size_t)H / (size_t)W ||
+        (size_t)H > SIZE_MAX / (size_t)W) {
+        return false; // Overflow would occur
+    }
+
+    // Additional check: ensure total elements calculation doesn't overflow
+    size_t total_elements = (size_t)N * C * H * W;
+    if (total_elements == 0 || total_elements > SIZE_MAX / element_size) {
+        return false;
+    }
+
+    // Validate memory boundaries
+    if (!validate_memory_boundaries(src, dst, total_elements, element_size)) {
+        return false;
+    }
+
+    // NCHW: [N][C][H*W] -> NHWC: [N][H*W][C]
+    size_t extents[3] = {(size_t)N, (size_t)C, (size_t)H * W};
+    size_t perm[3] = {0, 2, 1};
+    transpose_tensor_unchecked(src, dst, extents, 3, perm, element_size);
+    return true;
+}
+
+/**
+ * NHWC to NCHW layout conversion
+ * Each batch item is a (H*W) x C matrix transposed into C x (H*W),
+ * split across the worker pool when one is configured.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param N Batch size
+ * @param H Height
+ * @param W Width
+ * @param C Number of channels
+ * @param element_size Single element byte size
+ * @return Whether conversion was successful
+ */
+static inline bool convert_nhwc_to_nchw(const void* src, void* dst,
+                         int32_t N, int32_t H, int32_t W, int32_t C,
+                         size_t element_size) {
+    if (!src || !dst || N <= 0 || H <= 0 || W <= 0 || C <= 0 || element_size == 0) {
+        return false;
+    }
+
+    // Check for potential overflow in index calculations
+    if ((size_t)N > SIZE_MAX / (size_t)H / (size_t)W / (size_t)C ||
+        (size_t)H > SIZE_MAX / (size_t)W / (size_t)C ||
+        (size_t)W > SIZE_MAX / (size_t)C) {
+        return false; // Overflow would occur
+    }
+    // Additional check: ensure total elements calculation doesn't overflow
+    size_t total_elements = (size_t)N * H * W * C;
+    if (total_elements == 0 || total_elements > SIZE_MAX / element_size) {
+        return false;
+    }
+    // Validate memory boundaries
+    if (!validate_memory_boundaries(src, dst, total_elements, element_size)) {
+        return false;
+    }
+
+    // NHWC: [N][H*W][C] -> NCHW: [N][C][H*W]
+    size_t extents[3] = {(size_t)N, (size_t)H * W, (size_t)C};
+    size_t perm[3] = {0, 2, 1};
+    transpose_tensor_unchecked(src, dst, extents, 3, perm, element_size);
+    return true;
+}
+
+/**
+ * In-place transpose of a rows x cols matrix into cols x rows
+ * Follows the permutation cycles of the transpose, so only one element is
+ * held aside at a time. Position q of the result is taken from position
+ * (q % rows) * cols + q / rows of the source. An optional bitmap marks
+ * positions already moved; positions it does not cover are recognized by
+ * walking their cycle and checking that they are its smallest member.
+ * @param data Matrix data pointer
+ * @param rows Number of source rows
+ * @param cols Number of source columns
+ * @param element_size Single element byte size (at most 8)
+ * @param bitmap Scratch bitmap, may be NULL
+ * @param bitmap_bytes Bitmap size in bytes
+ */
+static inline void transpose_2d_inplace(void* data, size_t rows, size_t cols,
+                                        size_t element_size,
+                                        uint8_t* bitmap, size_t bitmap_bytes) {
+    char* base = (char*)data;
+    size_t total = rows * cols;
+    if (rows <= 1 || cols <= 1) {
+        return; // Transpose of a vector keeps the memory order
+    }
+
+    if (rows == cols) {
+        // Square: swap across the diagonal
+        char tmp[8];
+        for (size_t r = 0; r < rows; r++) {
+            for (size_t c = r + 1; c < cols; c++) {
+                char* a = base + (r * cols + c) * element_size;
+                char* b = base + (c * rows + r) * element_size;
+                memcpy(tmp, a, element_size);
+                memcpy(a, b, element_size);
+                memcpy(b, tmp, element_size);
+            }
+        }
+        return;
+    }
+
+    size_t bitmap_bits = bitmap ? bitmap_bytes * 8 : 0;
+    if (bitmap_bits > total) {
+        bitmap_bits = total;
+    }
+    if (bitmap_bits > 0) {
+        memset(bitmap, 0, (bitmap_bits + 7) / 8);
+    }
+
+    // First and last positions are fixed points
+    for (size_t start = 1; start + 1 < total; start++) {
+        if (start < bitmap_bits) {
+            if (bitmap[start >> 3] & (1u << (start & 7))) {
+                continue;
+            }
+        } else {
+            // Leader check: the cycle must not contain a smaller position
+            size_t q = (start % rows) * cols + start / rows;
+            while (q > start) {
+                q = (q % rows) * cols + q / rows;
+            }
+            if (q != start) {
+                continue;
+            }
+        }
+
+        char tmp[8];
+        size_t q = start;
+        memcpy(tmp, base + start * element_size, element_size);
+        for (;;) {
+            size_t from = (q % rows) * cols + q / rows;
+            if (q < bitmap_bits) {
+                bitmap[q >> 3] |= (uint8_t)(1u << (q & 7));
+            }
+            if (from == start) {
+                break;
+            }
+            memcpy(base + q * element_size, base + from * element_size, element_size);
+            q = from;
+        }
+        memcpy(base + q * element_size, tmp, element_size);
+    }
+}
+
+/**
+ * Axis permutation between two 4D layouts
+ * Activation layouts (NCHW, NHWC) convert among themselves, as do weight
+ * layouts (OIHW, OHWI, HWIO).
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param perm Output: destination axis i is source axis perm[i] (4 entries)
+ * @return Returns true if the pair is a supported permutation, false otherwise
+ */
+static inline bool get_layout_permutation(tensor_layout_t src_layout, tensor_layout_t dst_layout,
+                                          size_t* perm) {
+    // Position of each logical axis ([N,C,H,W] or [O,I,H,W]) in the layout
+    static const size_t axes[7][4] = {
+        {0, 0, 0, 0},   // LAYOUT_UNKNOWN
+        {0, 1, 2, 3},   // LAYOUT_NCHW
+        {0, 3, 1, 2},   // LAYOUT_NHWC
+        {0, 0, 0, 0},   // LAYOUT_GENERIC
+        {0, 1, 2, 3},   // LAYOUT_OIHW
+        {0, 3, 1, 2},   // LAYOUT_OHWI
+        {3, 2, 0, 1}    // LAYOUT_HWIO
+    };
+    bool src_weight = src_layout >= LAYOUT_OIHW && src_layout <= LAYOUT_HWIO;
+    bool dst_weight = dst_layout >= LAYOUT_OIHW && dst_layout <= LAYOUT_HWIO;
+    bool src_activation = src_layout == LAYOUT_NCHW || src_layout == LAYOUT_NHWC;
+    bool dst_activation = dst_layout == LAYOUT_NCHW || dst_layout == LAYOUT_NHWC;
+
+    if (src_layout == dst_layout ||
+        !((src_weight && dst_weight) || (src_activation && dst_activation))) {
+        return false;
+    }
+    for (size_t axis = 0; axis < 4; axis++) {
+        perm[axes[dst_layout][axis]] = axes[src_layout][axis];
+    }
+    return true;
+}
+
+/**
+ * Check whether a layout permutation runs as a batched 2D transpose
+ * True for every pair except OIHW <-> HWIO, which reverses three axis groups
+ * and goes through the general N-d transpose.
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return Returns true if the pair is a batched transpose, false otherwise
+ */
+static inline bool is_batched_layout_permutation(tensor_layout_t src_layout,
+                                                 tensor_layout_t dst_layout) {
+    size_t perm[4];
+    size_t extents[4] = {2, 3, 5, 7};   // Distinct extents: nothing merges by size
+    size_t simple_dims[4];
+    size_t simple_perm[4];
+    if (!get_layout_permutation(src_layout, dst_layout, perm)) {
+        return false;
+    }
+    size_t n = simplify_transpose_shape(extents, 4, perm, simple_dims, simple_perm);
+    return n <= 2 || (n == 3 && simple_perm[0] == 0 && simple_perm[1] == 2);
+}
+
+/**
+ * Batched transpose shape of a 4D layout conversion
+ * NCHW -> NHWC (and OIHW -> OHWI) is a batch of C x (H*W) transposes,
+ * NHWC -> NCHW a batch of (H*W) x C transposes; OHWI <-> HWIO is a single
+ * O x (H*W*I) transpose. Degenerate shapes (C == 1, H*W == 1) keep the
+ * memory order and need no transpose at all.
+ * @param dims Source dimensions (4 entries)
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format (is_batched_layout_permutation holds)
+ * @param dst_dims Output: destination dimensions (4 entries)
+ * @param batch Output: number of matrices
+ * @param rows Output: source rows per matrix
+ * @param cols Output: source columns per matrix
+ * @return Returns true if a transpose is needed, false if a plain copy suffices
+ */
+static inline bool get_layout_transpose_shape(const int32_t* dims, tensor_layout_t src_layout,
+                                              tensor_layout_t dst_layout, int32_t* dst_dims,
+                                              size_t* batch, size_t* rows, size_t* cols) {
+    size_t perm[4];
+    size_t extents[4];
+    size_t simple_dims[4];
+    size_t simple_perm[4];
+
+    get_layout_permutation(src_layout, dst_layout, perm);
+    for (size_t i = 0; i < 4; i++) {
+        extents[i] = (size_t)dims[i];
+        dst_dims[i] = dims[perm[i]];
+    }
+    size_t n = simplify_transpose_shape(extents, 4, perm, simple_dims, simple_perm);
+    if (n <= 1) {
+        return false;
+    }
+    if (n == 2) {
+        *batch = 1;
+        *rows = simple_dims[0];
+        *cols = simple_dims[1];
+    } else {
+        *batch = simple_dims[0];
+        *rows = simple_dims[1];
+        *cols = simple_dims[2];
+    }
+    return true;
+}
+
+/**
+ * In-place layout conversion between NCHW and NHWC
+ * Permutes each batch item inside the caller's buffer without allocating a
+ * second tensor. Weight layouts are converted the same way, except
+ * OIHW <-> HWIO (see is_batched_layout_permutation). A scratch bitmap of
+ * ceil(C*H*W / 8) bytes makes the cycle search linear; a smaller (or no)
+ * bitmap is valid and trades memory for extra cycle walks.
+ * @param data Tensor data pointer, converted in place
+ * @param dims Dimension array, permuted to the destination layout on success
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param scratch Scratch bitmap, may be NULL
+ * @param scratch_size Scratch bitmap size in bytes
+ * @return Whether conversion was successful
+ */
+static inline bool convert_layout_inplace(void* data, int32_t* dims, size_t num_dims,
+                                          tensor_data_type_t data_type,
+                                          tensor_layout_t src_layout,
+                                          tensor_layout_t dst_layout,
+                                          uint8_t* scratch, size_t scratch_size) {
+    if (!data || !dims || !validate_tensor_shape(dims, num_dims)) {
+        return false;
+    }
+    size_t element_size = get_data_type_size(data_type);
+    if (element_size == 0 || calculate_total_elements(dims, num_dims) == 0 ||
+        calculate_total_elements(dims, num_dims) > SIZE_MAX / element_size) {
+        return false;
+    }
+    if (num_dims != 4 || src_layout == dst_layout) {
+        return true; // Nothing to permute
+    }
+    if (!is_batched_layout_permutation(src_layout, dst_layout)) {
+        return false;
+    }
+
+    size_t batch = 0, rows = 0, cols = 0;
+    int32_t new_dims[4];
+    if (get_layout_transpose_shape(dims, src_layout, dst_layout, new_dims,
+                                   &batch, &rows, &cols)) {
+        size_t batch_bytes = rows * cols * element_size;
+        for (size_t n = 0; n < batch; n++) {
+            transpose_2d_inplace((char*)data + n * batch_bytes, rows, cols,
+                                 element_size, scratch, scratch_size);
+        }
+    }
+    memcpy(dims, new_dims, sizeof(new_dims));
+    return true;
+}
+
+/**
+ * Validate shape and data type shared by all conversion entry points
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param element_size Output: single element byte size
+ * @param total_elements Output: total number of elements
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if valid, false otherwise
+ */
+static inline bool validate_conversion_shape(const int32_t* dims, size_t num_dims,
+                                             tensor_data_type_t data_type,
+                                             size_t* element_size, size_t* total_elements,
+                                             char* error_msg, size_t error_msg_size) {
+    if (!validate_tensor_shape(dims, num_dims)) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_INVALID_DIMS);
+        return false;
+    }
+
+    *element_size = get_data_type_size(data_type);
+    if (*element_size == 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_UNSUPPORTED_TYPE ": %d", data_type);
+        return false;
+    }
+
+    *total_elements = calculate_total_elements(dims, num_dims);
+    if (*total_elements == 0) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_INVALID_DIMS);
+        return false;
+    }
+
+    // Check for overflow in total_bytes calculation
+    if (*total_elements > SIZE_MAX / *element_size) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_DIMS ": size too large");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Validate arguments shared by all conversion entry points
+ * @param data Source data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param element_size Output: single element byte size
+ * @param total_elements Output: total number of elements
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if valid, false otherwise
+ */
+static inline bool validate_conversion_args(const void* data, const int32_t* dims,
+                                            size_t num_dims, tensor_data_type_t data_type,
+                                            size_t* element_size, size_t* total_elements,
+                                            char* error_msg, size_t error_msg_size) {
+    if (!data || !dims || num_dims == 0) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+    return validate_conversion_shape(dims, num_dims, data_type, element_size, total_elements,
+                                     error_msg, error_msg_size);
+}
+
+/**
+ * Check whether a layout pair is supported and needs a permutation
+ * Only 4D tensors are permuted, between activation layouts or between
+ * weight layouts (see get_layout_permutation). Other pairs involving
+ * LAYOUT_UNKNOWN are copied as-is.
+ * @param num_dims Number of dimensions
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param need_permute Output: whether the data must be permuted
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if the pair is supported, false otherwise
+ */
+static inline bool check_layout_conversion(size_t num_dims,
+                                           tensor_layout_t src_layout,
+                                           tensor_layout_t dst_layout,
+                                           bool* need_permute,
+                                           char* error_msg, size_t error_msg_size) {
+    size_t perm[4];
+    *need_permute = false;
+    if (num_dims == 4 && src_layout != dst_layout) {
+        if (get_layout_permutation(src_layout, dst_layout, perm)) {
+            *need_permute = true;
+        } else if (src_layout != LAYOUT_UNKNOWN && dst_layout != LAYOUT_UNKNOWN) {
+            // Any other explicit layout conversion is not supported
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_LAYOUT_CONVERSION ": from %d to %d", src_layout, dst_layout);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Check a layout pair for the fused conversion kernels
+ * Fused type conversion, quantization and plans run batched 2D transposes,
+ * so OIHW <-> HWIO is only available through the plain conversions.
+ * @param num_dims Number of dimensions
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param need_permute Output: whether the data must be permuted
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if the pair is supported, false otherwise
+ */
+static inline bool check_fused_layout_conversion(size_t num_dims,
+                                                 tensor_layout_t src_layout,
+                                                 tensor_layout_t dst_layout,
+                                                 bool* need_permute,
+                                                 char* error_msg, size_t error_msg_size) {
+    if (!check_layout_conversion(num_dims, src_layout, dst_layout, need_permute,
+                                 error_msg, error_msg_size)) {
+        return false;
+    }
+    if (*need_permute && !is_batched_layout_permutation(src_layout, dst_layout)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_LAYOUT_CONVERSION ": from %d to %d cannot be fused",
+                src_layout, dst_layout);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Convolution weight layout conversion between OIHW, OHWI and HWIO
+ * OIHW <-> OHWI is a batch of I x (H*W) transposes (as NCHW <-> NHWC) and
+ * OHWI <-> HWIO a single O x (H*W*I) transpose. OIHW <-> HWIO reverses the
+ * axis groups and runs one strided O x (H*W) transpose per input channel.
+ * All of them use the tiled/SIMD block kernels and the worker pool.
+ * @param src Source data pointer
+ * @param dst Destination data pointer (must not overlap src)
+ * @param dims Source dimensions (4 entries)
+ * @param src_layout Source weight layout
+ * @param dst_layout Destination weight layout
+ * @param element_size Single element byte size
+ * @param dst_dims Output: destination dimensions (4 entries), may be NULL
+ * @return Whether conversion was successful
+ */
+static inline bool convert_weight_layout(const void* src, void* dst, const int32_t* dims,
+                                         tensor_layout_t src_layout,
+                                         tensor_layout_t dst_layout,
+                                         size_t element_size, int32_t* dst_dims) {
+    size_t perm[4] = {0, 1, 2, 3};
+    size_t extents[4];
+
+    if (!src || !dst || element_size == 0 || !validate_tensor_shape(dims, 4) ||
+        src_layout < LAYOUT_OIHW || src_layout > LAYOUT_HWIO ||
+        dst_layout < LAYOUT_OIHW || dst_layout > LAYOUT_HWIO) {
+        return false;
+    }
+    size_t total_elements = calculate_total_elements(dims, 4);
+    if (total_elements == 0 || total_elements > SIZE_MAX / element_size ||
+        !validate_memory_boundaries(src, dst, total_elements, element_size)) {
+        return false;
+    }
+
+    get_layout_permutation(src_layout, dst_layout, perm);
+    for (size_t i = 0; i < 4; i++) {
+        extents[i] = (size_t)dims[i];
+    }
+    if (dst_dims) {
+        for (size_t i = 0; i < 4; i++) {
+            dst_dims[i] = dims[perm[i]];
+        }
+    }
+    transpose_tensor_unchecked(src, dst, extents, 4, perm, element_size);
+    return true;
+}
+
+/**
+ * Convert tensor data and dimensions into destination buffers
+ * Permutes 4D tensors between NCHW and NHWC or between weight layouts,
+ * copies otherwise.
+ * @param src Source data pointer
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param element_size Single element byte size
+ * @param total_elements Total number of elements
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param dst Destination data pointer (total_elements * element_size bytes)
+ * @param dst_dims Destination dimension array (num_dims entries)
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool convert_layout_data(const void* src, const int32_t* dims, size_t num_dims,
+                                       size_t element_size, size_t total_elements,
+                                       tensor_layout_t src_layout, tensor_layout_t dst_layout,
+                                       void* dst, int32_t* dst_dims,
+                                       char* error_msg, size_t error_msg_size) {
+    // Check if layout conversion is needed
+    bool need_layout_conversion = false;
+    if (!check_layout_conversion(num_dims, src_layout, dst_layout, &need_layout_conversion,
+                                 error_msg, error_msg_size)) {
+        return false;
+    }
+
+    memcpy(dst_dims, dims, num_dims * sizeof(int32_t));
+    if (need_layout_conversion) {
+        bool converted = false;
+        if (src_layout >= LAYOUT_OIHW || dst_layout >= LAYOUT_OIHW) {
+            converted = convert_weight_layout(src, dst, dims, src_layout, dst_layout,
+                                              element_size, dst_dims);
+        } else if (src_layout == LAYOUT_NCHW && dst_layout == LAYOUT_NHWC) {
+            // Convert dimension order: [N,C,H,W] -> [N,H,W,C]
+            dst_dims[1] = dims[2]; // H (was at index 2)
+            dst_dims[2] = dims[3]; // W (was at index 3)
+            dst_dims[3] = dims[1]; // C (was at index 1)
+            converted = convert_nchw_to_nhwc(src, dst, dims[0], dims[1], dims[2], dims[3],
+                                             element_size);
+        } else {
+            // Convert dimension order: [N,H,W,C] -> [N,C,H,W]
+            dst_dims[1] = dims[3]; // C (was at index 3)
+            dst_dims[2] = dims[1]; // H (was at index 1)
+            dst_dims[3] = dims[2]; // W (was at index 2)
+            converted = convert_nhwc_to_nchw(src, dst, dims[0], dims[1], dims[2], dims[3],
+                                             element_size);
+        }
+        if (!converted) {
+            safe_snprintf(error_msg, error_msg_size, ERROR_MSG_LAYOUT_CONVERSION);
+            return false;
+        }
+    } else {
+        // No layout conversion needed, copy directly
+        if (!copy_tensor_data(src, dst, element_size, total_elements)) {
+            safe_snprintf(error_msg, error_msg_size, ERROR_MSG_DATA_COPY);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Conversion into newly allocated buffers (shared by both directions)
+ * With TENSOR_CONVERT_BORROW and no permutation needed, the result
+ * references src_data and dims instead of copying them.
+ */
+static inline conversion_result_t convert_tensor_alloc(const void* src_data,
+                                                       const int32_t* dims,
+                                                       size_t num_dims,
+                                                       tensor_data_type_t data_type,
+                                                       tensor_layout_t src_layout,
+                                                       tensor_layout_t dst_layout,
+                                                       uint32_t flags) {
+    conversion_result_t result = {0};
+    size_t element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(src_data, dims, num_dims, data_type,
+                                  &element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+
+    size_t total_bytes = element_size * total_elements;
+
+    if (flags & TENSOR_CONVERT_BORROW) {
+        bool need_permute = false;
+        if (!check_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                     result.error_msg, sizeof(result.error_msg))) {
+            return result;
+        }
+        if (!need_permute) {
+            // Same bytes and dims: reference the caller's memory
+            result.data = (void*)src_data;
+            result.shape.dims = (int32_t*)dims;
+            result.borrowed = true;
+            result.shape.num_dims = num_dims;
+            result.shape.data_type = data_type;
+            result.shape.total_elements = total_elements;
+            result.shape.layout = dst_layout;
+            result.data_size = total_bytes;
+            result.success = true;
+            return result;
+        }
+    }
+
+    // Allocate memory for converted data
+    result.data = malloc(total_bytes);
+    if (!result.data) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_MEMORY_ALLOC ": %zu bytes", total_bytes);
+        return result;
+    }
+
+    // Allocate dimension information
+    result.shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
+    if (!result.shape.dims) {
+        free(result.data);
+        result.data = NULL;
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_MEMORY_ALLOC);
+        return result;
+    }
+
+    if (!convert_layout_data(src_data, dims, num_dims, element_size, total_elements,
+                             src_layout, dst_layout, result.data, result.shape.dims,
+                             result.error_msg, sizeof(result.error_msg))) {
+        free(result.data);
+        free(result.shape.dims);
+        result.data = NULL;
+        result.shape.dims = NULL;
+        return result;
+    }
+
+    // Set result information
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = data_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+/**
+ * Conversion into caller-provided buffers (shared by both directions)
+ */
+static inline conversion_result_t convert_tensor_into(const void* src_data,
+                                                      const int32_t* dims,
+                                                      size_t num_dims,
+                                                      tensor_data_type_t data_type,
+                                                      tensor_layout_t src_layout,
+                                                      tensor_layout_t dst_layout,
+                                                      void* dst_data,
+                                                      size_t dst_capacity,
+                                                      int32_t* dst_dims,
+                                                      size_t dst_dims_capacity) {
+    conversion_result_t result = {0};
+    size_t element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(src_data, dims, num_dims, data_type,
+                                  &element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (!dst_data || !dst_dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+
+    size_t total_bytes = element_size * total_elements;
+    if (dst_capacity < total_bytes) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_BUFFER_TOO_SMALL ": need %zu bytes, have %zu",
+                total_bytes, dst_capacity);
+        return result;
+    }
+    if (dst_dims_capacity < num_dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_BUFFER_TOO_SMALL ": need %zu dims, have %zu",
+                num_dims, dst_dims_capacity);
+        return result;
+    }
+
+    if (!convert_layout_data(src_data, dims, num_dims, element_size, total_elements,
+                             src_layout, dst_layout, dst_data, dst_dims,
+                             result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+
+    result.data = dst_data;
+    result.shape.dims = dst_dims;
+    result.borrowed = true;
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = data_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+/**
+ * ONNX to TFLite conversion with layout conversion
+ * @param onnx_data ONNX tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout(const void* onnx_data,
+                                                          const int32_t* dims,
+                                                          size_t num_dims,
+                                                          tensor_data_type_t data_type,
+                                                          tensor_layout_t src_layout,
+                                                          tensor_layout_t dst_layout) {
+    return convert_tensor_alloc(onnx_data, dims, num_dims, data_type, src_layout, dst_layout, 0);
+}
+
+/**
+ * TFLite to ONNX conversion with layout conversion
+ * @param tflite_data TFLite tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout(const void* tflite_data,
+                                                          const int32_t* dims,
+                                                          size_t num_dims,
+                                                          tensor_data_type_t data_type,
+                                                          tensor_layout_t src_layout,
+                                                          tensor_layout_t dst_layout) {
+    return convert_tensor_alloc(tflite_data, dims, num_dims, data_type, src_layout, dst_layout, 0);
+}
+
+/**
+ * ONNX to TFLite conversion with options
+ * With TENSOR_CONVERT_BORROW, a tensor that needs no permutation (same
+ * layout, non-4D, or an unknown side) is not copied: the result references
+ * onnx_data and dims, is marked borrowed and must not outlive them or be
+ * written through. Otherwise behaves like onnx_to_tflite_with_layout.
+ * @param onnx_data ONNX tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param flags Bitwise OR of TENSOR_CONVERT_* flags
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout_ex(const void* onnx_data,
+                                                             const int32_t* dims,
+                                                             size_t num_dims,
+                                                             tensor_data_type_t data_type,
+                                                             tensor_layout_t src_layout,
+                                                             tensor_layout_t dst_layout,
+                                                             uint32_t flags) {
+    return convert_tensor_alloc(onnx_data, dims, num_dims, data_type, src_layout, dst_layout,
+                                flags);
+}
+
+/**
+ * TFLite to ONNX conversion with options
+ * See onnx_to_tflite_with_layout_ex for the flags.
+ * @param tflite_data TFLite tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param flags Bitwise OR of TENSOR_CONVERT_* flags
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout_ex(const void* tflite_data,
+                                                             const int32_t* dims,
+                                                             size_t num_dims,
+                                                             tensor_data_type_t data_type,
+                                                             tensor_layout_t src_layout,
+                                                             tensor_layout_t dst_layout,
+                                                             uint32_t flags) {
+    return convert_tensor_alloc(tflite_data, dims, num_dims, data_type, src_layout, dst_layout,
+                                flags);
+}
+
+/**
+ * ONNX to TFLite conversion into caller-provided buffers
+ * Allocates nothing. The result references dst_data and dst_dims and is
+ * marked borrowed, so free_conversion_result leaves them alone.
+ * @param onnx_data ONNX tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param dst_data Destination data buffer
+ * @param dst_capacity Destination data buffer size in bytes
+ * @param dst_dims Destination dimension array
+ * @param dst_dims_capacity Destination dimension array length
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout_into(const void* onnx_data,
+                                                               const int32_t* dims,
+                                                               size_t num_dims,
+                                                               tensor_data_type_t data_type,
+                                                               tensor_layout_t src_layout,
+                                                               tensor_layout_t dst_layout,
+                                                               void* dst_data,
+                                                               size_t dst_capacity,
+                                                               int32_t* dst_dims,
+                                                               size_t dst_dims_capacity) {
+    return convert_tensor_into(onnx_data, dims, num_dims, data_type, src_layout, dst_layout,
+                               dst_data, dst_capacity, dst_dims, dst_dims_capacity);
+}
+
+/**
+ * TFLite to ONNX conversion into caller-provided buffers
+ * Allocates nothing. The result references dst_data and dst_dims and is
+ * marked borrowed, so free_conversion_result leaves them alone.
+ * @param tflite_data TFLite tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param dst_data Destination data buffer
+ * @param dst_capacity Destination data buffer size in bytes
+ * @param dst_dims Destination dimension array
+ * @param dst_dims_capacity Destination dimension array length
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout_into(const void* tflite_data,
+                                                               const int32_t* dims,
+                                                               size_t num_dims,
+                                                               tensor_data_type_t data_type,
+                                                               tensor_layout_t src_layout,
+                                                               tensor_layout_t dst_layout,
+                                                               void* dst_data,
+                                                               size_t dst_capacity,
+                                                               int32_t* dst_dims,
+                                                               size_t dst_dims_capacity) {
+    return convert_tensor_into(tflite_data, dims, num_dims, data_type, src_layout, dst_layout,
+                               dst_data, dst_capacity, dst_dims, dst_dims_capacity);
+}
+
+/**
+ * Chunk passed to a streaming conversion callback
+ * Rows are the flattened first two destination axes (e.g. [N, H] for
+ * NHWC, [N, C] for NCHW; [N] for 1-D tensors).
+ */
+typedef struct {
+    const void* data;               // Converted bytes, valid until the callback returns
+    size_t data_size;               // Chunk size in bytes
+    size_t offset;                  // Byte offset of the chunk in the destination tensor
+    size_t row_begin;               // First destination row in the chunk
+    size_t row_count;               // Destination rows in the chunk
+    const tensor_shape_t* shape;    // Destination shape
+} tensor_stream_chunk_t;
+
+/**
+ * Streaming conversion callback
+ * @param chunk Converted chunk
+ * @param user_data User pointer passed to the streaming call
+ * @return Returns true to continue, false to abort the conversion
+ */
+typedef bool (*tensor_stream_fn)(const tensor_stream_chunk_t* chunk, void* user_data);
+
+/**
+ * Streaming conversion state
+ */
+typedef struct {
+    const char* src;
+    size_t element_size;
+    bool need_permute;
+    size_t rows_per_batch;      // Destination rows per batch item
+    size_t row_bytes;           // Bytes per destination row
+    size_t matrix_rows;         // Source matrix rows per batch item (permuted)
+    size_t matrix_cols;         // Source matrix columns per batch item (permuted)
+    size_t group;               // Source matrix columns per destination row (permuted)
+    transpose_block_fn kernel;
+    size_t tile;
+} tensor_stream_ctx_t;
+
+/**
+ * Convert a range of destination rows into a window
+ * Whole batch items go through the batched transpose; partial ones are
+ * strided sub-matrix transposes of a single batch item.
+ */
+static inline void convert_stream_rows(const tensor_stream_ctx_t* ctx, size_t row,
+                                       size_t count, char* window) {
+    if (!ctx->need_permute) {
+        memcpy(window, ctx->src + row * ctx->row_bytes, count * ctx->row_bytes);
+        return;
+    }
+
+    size_t batch_bytes = ctx->rows_per_batch * ctx->row_bytes;
+    size_t end = row + count;
+    while (row < end) {
+        size_t n = row / ctx->rows_per_batch;
+        size_t first = row % ctx->rows_per_batch;
+        const char* src_batch = ctx->src + n * batch_bytes;
+        if (first == 0 && end - row >= ctx->rows_per_batch) {
+            size_t batch = (end - row) / ctx->rows_per_batch;
+            transpose_batched_with(src_batch, window, batch, ctx->matrix_rows, ctx->matrix_cols,
+                                   ctx->element_size, ctx->kernel, ctx->tile);
+            row += batch * ctx->rows_per_batch;
+            window += batch * batch_bytes;
+            continue;
+        }
+        size_t run = ctx->rows_per_batch - first;
+        if (run > end - row) {
+            run = end - row;
+        }
+        transpose_2d_blocked(src_batch + first * ctx->group * ctx->element_size, window,
+                             ctx->matrix_rows, run * ctx->group,
+                             ctx->matrix_cols, ctx->matrix_rows,
+                             ctx->element_size, ctx->kernel, ctx->tile);
+        row += run;
+        window += run * ctx->row_bytes;
+    }
+}
+
+/**
+ * Tensor conversion streamed through a caller window
+ * The destination is produced chunk_rows destination rows at a time into
+ * window, and callback is invoked after each chunk, so memory stays bounded
+ * by the window whatever the tensor size. Chunk offsets allow writing each
+ * chunk straight to its place in a file or buffer.
+ * @param src_data Source data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param chunk_rows Destination rows per chunk, 0 for as many as fit in the window
+ *                   (dst dims[1] rows stream one N-slice per chunk)
+ * @param window Output window reused for every chunk
+ * @param window_size Output window size in bytes
+ * @param callback Chunk callback
+ * @param user_data User pointer passed to the callback
+ * @return conversion_result_t Result with the destination shape and size, no data
+ */
+static inline conversion_result_t convert_tensor_stream(const void* src_data,
+                                                        const int32_t* dims,
+                                                        size_t num_dims,
+                                                        tensor_data_type_t data_type,
+                                                        tensor_layout_t src_layout,
+                                                        tensor_layout_t dst_layout,
+                                                        size_t chunk_rows,
+                                                        void* window,
+                                                        size_t window_size,
+                                                        tensor_stream_fn callback,
+                                                        void* user_data) {
+    conversion_result_t result = {0};
+    tensor_stream_ctx_t ctx;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(src_data, dims, num_dims, data_type,
+                                  &ctx.element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (!window || !callback) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (!check_layout_conversion(num_dims, src_layout, dst_layout, &ctx.need_permute,
+                                 result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (ctx.need_permute && (src_layout == LAYOUT_HWIO || dst_layout == LAYOUT_HWIO)) {
+        // Chunks are slices of the leading axis, which HWIO moves
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_LAYOUT_CONVERSION ": from %d to %d cannot be streamed",
+                src_layout, dst_layout);
+        return result;
+    }
+
+    result.shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
+    if (!result.shape.dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_MEMORY_ALLOC);
+        return result;
+    }
+    memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = data_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+
+    ctx.src = (const char*)src_data;
+    if (ctx.need_permute) {
+        size_t batch = 0;
+        get_layout_transpose_shape(dims, src_layout, dst_layout, result.shape.dims,
+                                   &batch, &ctx.matrix_rows, &ctx.matrix_cols);
+        // Unsimplified per-batch matrix: rows are read as column ranges of it
+        if (src_layout == LAYOUT_NCHW || src_layout == LAYOUT_OIHW) {
+            ctx.matrix_rows = (size_t)dims[1];
+            ctx.matrix_cols = (size_t)dims[2] * (size_t)dims[3];
+            ctx.group = (size_t)dims[3];
+        } else {
+            ctx.matrix_rows = (size_t)dims[1] * (size_t)dims[2];
+            ctx.matrix_cols = (size_t)dims[3];
+            ctx.group = 1;
+        }
+        ctx.kernel = get_transpose_block_kernel(ctx.element_size);
+        ctx.tile = get_transpose_tile(ctx.element_size, 0);
+    }
+    size_t total_rows = (size_t)dims[0] * (num_dims > 1 ? (size_t)result.shape.dims[1] : 1);
+    size_t total_bytes = total_elements * ctx.element_size;
+    ctx.rows_per_batch = num_dims > 1 ? (size_t)result.shape.dims[1] : 1;
+    ctx.row_bytes = total_bytes / total_rows;
+
+    if (chunk_rows == 0) {
+        chunk_rows = window_size / ctx.row_bytes;
+    }
+    if (chunk_rows == 0 || chunk_rows > window_size / ctx.row_bytes) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_BUFFER_TOO_SMALL ": need %zu bytes per chunk, have %zu",
+                (chunk_rows ? chunk_rows : 1) * ctx.row_bytes, window_size);
+        free(result.shape.dims);
+        result.shape.dims = NULL;
+        return result;
+    }
+
+    for (size_t row = 0; row < total_rows; row += chunk_rows) {
+        tensor_stream_chunk_t chunk;
+        size_t count = (total_rows - row < chunk_rows) ? total_rows - row : chunk_rows;
+        convert_stream_rows(&ctx, row, count, (char*)window);
+        chunk.data = window;
+        chunk.data_size = count * ctx.row_bytes;
+        chunk.offset = row * ctx.row_bytes;
+        chunk.row_begin = row;
+        chunk.row_count = count;
+        chunk.shape = &result.shape;
+        if (!callback(&chunk, user_data)) {
+            safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                    ERROR_MSG_STREAM_ABORTED ": at row %zu of %zu", row, total_rows);
+            free(result.shape.dims);
+            result.shape.dims = NULL;
+            return result;
+        }
+    }
+
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+/**
+ * ONNX to TFLite conversion streamed through a caller window
+ * See convert_tensor_stream.
+ * @param onnx_data ONNX tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param chunk_rows Destination rows per chunk, 0 for as many as fit in the window
+ * @param window Output window reused for every chunk
+ * @param window_size Output window size in bytes
+ * @param callback Chunk callback
+ * @param user_data User pointer passed to the callback
+ * @return conversion_result_t Result with the destination shape and size, no data
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout_stream(
+    const void* onnx_data, const int32_t* dims, size_t num_dims,
+    tensor_data_type_t data_type, tensor_layout_t src_layout, tensor_layout_t dst_layout,
+    size_t chunk_rows, void* window, size_t window_size,
+    tensor_stream_fn callback, void* user_data) {
+    return convert_tensor_stream(onnx_data, dims, num_dims, data_type, src_layout, dst_layout,
+                                 chunk_rows, window, window_size, callback, user_data);
+}
+
+/**
+ * TFLite to ONNX conversion streamed through a caller window
+ * See convert_tensor_stream.
+ * @param tflite_data TFLite tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param chunk_rows Destination rows per chunk, 0 for as many as fit in the window
+ * @param window Output window reused for every chunk
+ * @param window_size Output window size in bytes
+ * @param callback Chunk callback
+ * @param user_data User pointer passed to the callback
+ * @return conversion_result_t Result with the destination shape and size, no data
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout_stream(
+    const void* tflite_data, const int32_t* dims, size_t num_dims,
+    tensor_data_type_t data_type, tensor_layout_t src_layout, tensor_layout_t dst_layout,
+    size_t chunk_rows, void* window, size_t window_size,
+    tensor_stream_fn callback, void* user_data) {
+    return convert_tensor_stream(tflite_data, dims, num_dims, data_type, src_layout, dst_layout,
+                                 chunk_rows, window, window_size, callback, user_data);
+}
+
+/**
+ * Index of a fused data type conversion
+ * @param src_type Source data type
+ * @param dst_type Destination data type
+ * @return tensor_cast_t value, or -1 if the pair has no conversion kernel
+ */
+static inline int get_cast_index(tensor_data_type_t src_type, tensor_data_type_t dst_type) {
+    if (src_type == TENSOR_FLOAT32 && dst_type == TENSOR_FLOAT16) {
+        return TENSOR_CAST_F32_TO_F16;
+    }
+    if (src_type == TENSOR_FLOAT16 && dst_type == TENSOR_FLOAT32) {
+        return TENSOR_CAST_F16_TO_F32;
+    }
+    return -1;
+}
+
+/**
+ * Contiguous conversion task context
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t count;             // Total number of elements
+    size_t chunk;             // Elements per work item
+    size_t src_element_size;
+    size_t dst_element_size;
+    convert_row_fn convert;
+} convert_rows_ctx_t;
+
+static inline void convert_rows_task(void* arg, size_t begin, size_t end) {
+    const convert_rows_ctx_t* ctx = (const convert_rows_ctx_t*)arg;
+    for (size_t item = begin; item < end; item++) {
+        size_t start = item * ctx->chunk;
+        size_t count = (ctx->count - start < ctx->chunk) ? ctx->count - start : ctx->chunk;
+        ctx->convert(ctx->src + start * ctx->src_element_size,
+                     ctx->dst + start * ctx->dst_element_size, count);
+    }
+}
+
+/**
+ * Convert the data type of a tensor without permuting it
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param total_elements Total number of elements
+ * @param cast Conversion to apply
+ * @param src_element_size Source element byte size
+ * @param dst_element_size Destination element byte size
+ */
+static inline void convert_tensor_type(const void* src, void* dst, size_t total_elements,
+                                       tensor_cast_t cast,
+                                       size_t src_element_size, size_t dst_element_size) {
+    convert_rows_ctx_t ctx;
+    size_t max_element_size = src_element_size > dst_element_size ? src_element_size
+                                                                   : dst_element_size;
+    ctx.src = (const char*)src;
+    ctx.dst = (char*)dst;
+    ctx.count = total_elements;
+    ctx.chunk = TENSOR_CONVERTER_PARALLEL_GRAIN / max_element_size;
+    ctx.src_element_size = src_element_size;
+    ctx.dst_element_size = dst_element_size;
+    ctx.convert = get_kernel_table()->convert_row[cast];
+    parallel_for(convert_rows_task, &ctx, (total_elements + ctx.chunk - 1) / ctx.chunk,
+                 total_elements * max_element_size / TENSOR_CONVERTER_PARALLEL_GRAIN);
+}
+
+/**
+ * Layout conversion with a fused data type conversion into a destination buffer
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param total_elements Total number of elements
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param need_permute Whether the layout permutation is applied
+ * @param cast Conversion to apply
+ * @param src_element_size Source element byte size
+ * @param dst_element_size Destination element byte size
+ * @param dst_dims Output: destination dimensions
+ */
+static inline void convert_layout_cast_data(const void* src, void* dst,
+                                            const int32_t* dims, size_t num_dims,
+                                            size_t total_elements,
+                                            tensor_layout_t src_layout, tensor_layout_t dst_layout,
+                                            bool need_permute,
+                                            tensor_cast_t cast,
+                                            size_t src_element_size, size_t dst_element_size,
+                                            int32_t* dst_dims) {
+    size_t batch = 0, rows = 0, cols = 0;
+    memcpy(dst_dims, dims, num_dims * sizeof(int32_t));
+    if (need_permute &&
+        get_layout_transpose_shape(dims, src_layout, dst_layout, dst_dims,
+                                   &batch, &rows, &cols)) {
+        const tensor_kernel_table_t* table = get_kernel_table();
+        size_t block_edge = table->transpose_cast_block_edge[cast];
+        size_t tile = (TENSOR_CONVERTER_TILE_SIZE + block_edge - 1) / block_edge * block_edge;
+        transpose_batched_cast(src, dst, batch, rows, cols,
+                               src_element_size, dst_element_size,
+                               table->transpose_cast_block[cast], tile);
+    } else {
+        convert_tensor_type(src, dst, total_elements, cast, src_element_size, dst_element_size);
+    }
+}
+
+/**
+ * Allocate the data and dims of a conversion result
+ * @param result Result to fill; error_msg is set on failure
+ * @param total_bytes Data size in bytes
+ * @param num_dims Number of dimensions
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool allocate_conversion_result(conversion_result_t* result,
+                                              size_t total_bytes, size_t num_dims) {
+    result->data = malloc(total_bytes);
+    if (!result->data) {
+        safe_snprintf(result->error_msg, sizeof(result->error_msg),
+                ERROR_MSG_MEMORY_ALLOC ": %zu bytes", total_bytes);
+        return false;
+    }
+    result->shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
+    if (!result->shape.dims) {
+        free(result->data);
+        result->data = NULL;
+        safe_snprintf(result->error_msg, sizeof(result->error_msg),
+                ERROR_MSG_MEMORY_ALLOC);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Source data aligned for the typed conversion kernels
+ * Data that is not aligned to its element size is copied to a temporary
+ * buffer; aligned data is used in place.
+ * @param data Source data pointer
+ * @param data_size Source data size in bytes
+ * @param element_size Source element byte size
+ * @param copy Output: temporary buffer to free, NULL if data is used in place
+ * @param error_msg Buffer for error message
+ * @param error_msg_size Size of error_msg buffer
+ * @return Aligned source pointer, NULL on allocation failure
+ */
+static inline const void* get_aligned_source(const void* data, size_t data_size,
+                                             size_t element_size, void** copy,
+                                             char* error_msg, size_t error_msg_size) {
+    *copy = NULL;
+    if (element_size == 0 || (uintptr_t)data % element_size == 0) {
+        return data;
+    }
+    *copy = malloc(data_size);
+    if (!*copy) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_MEMORY_ALLOC ": %zu bytes", data_size);
+        return NULL;
+    }
+    memcpy(*copy, data, data_size);
+    return *copy;
+}
+
+/**
+ * Conversion of layout and data type in one pass (shared by both directions)
+ * Each element is read once and written once: the conversion runs inside
+ * the transpose block kernels, or over contiguous rows when the layout
+ * needs no permutation.
+ */
+static inline conversion_result_t convert_tensor_cast_alloc(const void* src_data,
+                                                            const int32_t* dims,
+                                                            size_t num_dims,
+                                                            tensor_data_type_t src_type,
+                                                            tensor_data_type_t dst_type,
+                                                            tensor_layout_t src_layout,
+                                                            tensor_layout_t dst_layout) {
+    conversion_result_t result = {0};
+    size_t src_element_size = 0;
+    size_t total_elements = 0;
+
+    if (src_type == dst_type) {
+        return convert_tensor_alloc(src_data, dims, num_dims, src_type, src_layout, dst_layout, 0);
+    }
+    if (!validate_conversion_args(src_data, dims, num_dims, src_type,
+                                  &src_element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    int cast = get_cast_index(src_type, dst_type);
+    if (cast < 0) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_UNSUPPORTED_TYPE ": from %d to %d", src_type, dst_type);
+        return result;
+    }
+    size_t dst_element_size = get_data_type_size(dst_type);
+    if (total_elements > SIZE_MAX / dst_element_size) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": size too large");
+        return result;
+    }
+    bool need_permute = false;
+    if (!check_fused_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                       result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+
+    void* copy = NULL;
+    const void* src = get_aligned_source(src_data, src_element_size * total_elements,
+                                         src_element_size, &copy,
+                                         result.error_msg, sizeof(result.error_msg));
+    if (!src) {
+        return result;
+    }
+    size_t total_bytes = dst_element_size * total_elements;
+    if (!allocate_conversion_result(&result, total_bytes, num_dims)) {
+        free(copy);
+        return result;
+    }
+
+    convert_layout_cast_data(src, result.data, dims, num_dims, total_elements,
+                             src_layout, dst_layout, need_permute, (tensor_cast_t)cast,
+                             src_element_size, dst_element_size, result.shape.dims);
+    free(copy);
+
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = dst_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+/**
+ * ONNX to TFLite conversion with layout and data type conversion
+ * Supported type pairs: float32 <-> float16 (round to nearest even), plus
+ * any type to itself. The cast is fused into the layout pass.
+ * @param onnx_data ONNX tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param src_type Source data type
+ * @param dst_type Destination data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout_cast(const void* onnx_data,
+                                                               const int32_t* dims,
+                                                               size_t num_dims,
+                                                               tensor_data_type_t src_type,
+                                                               tensor_data_type_t dst_type,
+                                                               tensor_layout_t src_layout,
+                                                               tensor_layout_t dst_layout) {
+    return convert_tensor_cast_alloc(onnx_data, dims, num_dims, src_type, dst_type,
+                                     src_layout, dst_layout);
+}
+
+/**
+ * TFLite to ONNX conversion with layout and data type conversion
+ * See onnx_to_tflite_with_layout_cast for the supported type pairs.
+ * @param tflite_data TFLite tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param src_type Source data type
+ * @param dst_type Destination data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout_cast(const void* tflite_data,
+                                                               const int32_t* dims,
+                                                               size_t num_dims,
+                                                               tensor_data_type_t src_type,
+                                                               tensor_data_type_t dst_type,
+                                                               tensor_layout_t src_layout,
+                                                               tensor_layout_t dst_layout) {
+    return convert_tensor_cast_alloc(tflite_data, dims, num_dims, src_type, dst_type,
+                                     src_layout, dst_layout);
+}
+
+/**
+ * Convolution weight conversion into a newly allocated result (shared by the weight entry points)
+ * Runs a single convert_weight_layout pass; the result takes the dims and
+ * layout given by the caller, which may regroup the permuted axes.
+ * @param src_data Source weight data pointer
+ * @param dims Source dimensions in src_layout (4 entries)
+ * @param data_type Data type
+ * @param src_layout Source weight layout
+ * @param dst_layout Destination weight layout the data is permuted to
+ * @param result_dims Result dimensions (4 entries, same element count)
+ * @param result_layout Layout recorded in the result
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t convert_weight_alloc(const void* src_data, const int32_t* dims,
+                                                       tensor_data_type_t data_type,
+                                                       tensor_layout_t src_layout,
+                                                       tensor_layout_t dst_layout,
+                                                       const int32_t* result_dims,
+                                                       tensor_layout_t result_layout) {
+    conversion_result_t result = {0};
+    size_t element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(src_data, dims, 4, data_type, &element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    size_t total_bytes = element_size * total_elements;
+    if (!allocate_conversion_result(&result, total_bytes, 4)) {
+        return result;
+    }
+    if (!convert_weight_layout(src_data, result.data, dims, src_layout, dst_layout,
+                               element_size, NULL)) {
+        free(result.data);
+        free(result.shape.dims);
+        result.data = NULL;
+        result.shape.dims = NULL;
+        safe_snprintf(result.error_msg, sizeof(result.error_msg), ERROR_MSG_LAYOUT_CONVERSION);
+        return result;
+    }
+
+    memcpy(result.shape.dims, result_dims, 4 * sizeof(int32_t));
+    result.shape.num_dims = 4;
+    result.shape.data_type = data_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = result_layout;
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+/**
+ * ONNX depthwise Conv weights to TFLite DEPTHWISE_CONV_2D weights
+ * [C*M, 1, H, W] -> [1, H, W, C*M] (M: channel multiplier) as a single
+ * (C*M) x (H*W) tiled transpose. Output channel c*M + m keeps its index.
+ * @param onnx_data ONNX weight data pointer
+ * @param dims ONNX dimensions [C*M, 1, H, W]
+ * @param data_type Data type
+ * @return conversion_result_t Conversion result ([1, H, W, C*M], LAYOUT_GENERIC)
+ */
+static inline conversion_result_t onnx_to_tflite_depthwise_weights(const void* onnx_data,
+                                                                   const int32_t* dims,
+                                                                   tensor_data_type_t data_type) {
+    conversion_result_t result = {0};
+    if (!dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg), ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (dims[1] != 1) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": depthwise weights need dims[1] == 1, got %d", dims[1]);
+        return result;
+    }
+    // [C*M,1,H,W] as OIHW is [H,W,1,C*M] as HWIO: the TFLite bytes
+    int32_t tflite_dims[4] = {1, dims[2], dims[3], dims[0]};
+    return convert_weight_alloc(onnx_data, dims, data_type, LAYOUT_OIHW, LAYOUT_HWIO,
+                                tflite_dims, LAYOUT_GENERIC);
+}
+
+/**
+ * TFLite DEPTHWISE_CONV_2D weights to ONNX depthwise Conv weights
+ * [1, H, W, C*M] -> [C*M, 1, H, W] as a single (H*W) x (C*M) tiled transpose.
+ * @param tflite_data TFLite weight data pointer
+ * @param dims TFLite dimensions [1, H, W, C*M]
+ * @param data_type Data type
+ * @return conversion_result_t Conversion result ([C*M, 1, H, W], LAYOUT_OIHW)
+ */
+static inline conversion_result_t tflite_to_onnx_depthwise_weights(const void* tflite_data,
+                                                                   const int32_t* dims,
+                                                                   tensor_data_type_t data_type) {
+    conversion_result_t result = {0};
+    if (!dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg), ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (dims[0] != 1) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": depthwise weights need dims[0] == 1, got %d", dims[0]);
+        return result;
+    }
+    int32_t hwio_dims[4] = {dims[1], dims[2], 1, dims[3]};
+    int32_t onnx_dims[4] = {dims[3], 1, dims[1], dims[2]};
+    return convert_weight_alloc(tflite_data, hwio_dims, data_type, LAYOUT_HWIO, LAYOUT_OIHW,
+                                onnx_dims, LAYOUT_OIHW);
+}
+
+/**
+ * Check the group count of grouped convolution weights
+ * @param num_filters Number of output channels (O)
+ * @param groups Number of groups
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if valid, false otherwise
+ */
+static inline bool validate_weight_groups(int32_t num_filters, size_t groups,
+                                          char* error_msg, size_t error_msg_size) {
+    if (groups == 0 || num_filters <= 0 || (size_t)num_filters % groups != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_DIMS ": %d filters do not split into %zu groups",
+                num_filters, groups);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * ONNX grouped Conv weights to TFLite grouped CONV_2D weights
+ * [O, I/g, H, W] -> [O, H, W, I/g] in one pass. Filters stay ordered by
+ * group, so group k is the contiguous slice of O/g filters starting at
+ * byte k * data_size / groups; models that split the convolution per group
+ * use these slices directly, without a copy.
+ * @param onnx_data ONNX weight data pointer
+ * @param dims ONNX dimensions [O, I/g, H, W]
+ * @param groups Number of groups (Conv group attribute), must divide O
+ * @param data_type Data type
+ * @return conversion_result_t Conversion result ([O, H, W, I/g], LAYOUT_OHWI)
+ */
+static inline conversion_result_t onnx_to_tflite_grouped_weights(const void* onnx_data,
+                                                                 const int32_t* dims,
+                                                                 size_t groups,
+                                                                 tensor_data_type_t data_type) {
+    conversion_result_t result = {0};
+    if (!dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg), ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (!validate_weight_groups(dims[0], groups, result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    int32_t tflite_dims[4] = {dims[0], dims[2], dims[3], dims[1]};
+    return convert_weight_alloc(onnx_data, dims, data_type, LAYOUT_OIHW, LAYOUT_OHWI,
+                                tflite_dims, LAYOUT_OHWI);
+}
+
+/**
+ * TFLite grouped CONV_2D weights to ONNX grouped Conv weights
+ * [O, H, W, I/g] -> [O, I/g, H, W] in one pass.
+ * @param tflite_data TFLite weight data pointer
+ * @param dims TFLite dimensions [O, H, W, I/g]
+ * @param groups Number of groups, must divide O
+ * @param data_type Data type
+ * @return conversion_result_t Conversion result ([O, I/g, H, W], LAYOUT_OIHW)
+ */
+static inline conversion_result_t tflite_to_onnx_grouped_weights(const void* tflite_data,
+                                                                 const int32_t* dims,
+                                                                 size_t groups,
+                                                                 tensor_data_type_t data_type) {
+    conversion_result_t result = {0};
+    if (!dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg), ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (!validate_weight_groups(dims[0], groups, result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    int32_t onnx_dims[4] = {dims[0], dims[3], dims[1], dims[2]};
+    return convert_weight_alloc(tflite_data, dims, data_type, LAYOUT_OHWI, LAYOUT_OIHW,
+                                onnx_dims, LAYOUT_OIHW);
+}
+
+/**
+ * Reverse the order of fixed-size rows inside each block, in place
+ * @param data Data pointer
+ * @param num_blocks Number of blocks
+ * @param rows Rows per block
+ * @param row_bytes Row size in bytes
+ */
+static inline void reverse_block_rows(void* data, size_t num_blocks, size_t rows,
+                                      size_t row_bytes) {
+    unsigned char tmp[256];
+    for (size_t b = 0; b < num_blocks; b++) {
+        unsigned char* block = (unsigned char*)data + b * rows * row_bytes;
+        for (size_t r = 0; r < rows / 2; r++) {
+            unsigned char* a = block + r * row_bytes;
+            unsigned char* z = block + (rows - 1 - r) * row_bytes;
+            for (size_t done = 0; done < row_bytes; done += sizeof(tmp)) {
+                size_t n = row_bytes - done < sizeof(tmp) ? row_bytes - done : sizeof(tmp);
+                memcpy(tmp, a + done, n);
+                memcpy(a + done, z + done, n);
+                memcpy(z + done, tmp, n);
+            }
+        }
+    }
+}
+
+/**
+ * Flipped transposed-convolution weight task context
+ * Each work item is one destination filter: a (C_in/g) x (kH*kW) transpose
+ * whose kH*kW rows are reversed while the block is still in cache.
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t filters_per_group;   // C_out/g
+    size_t in_per_group;        // C_in/g
+    size_t kernel_size;         // kH*kW
+    size_t element_size;
+    transpose_block_fn kernel;
+    size_t tile;
+} transpose_conv_flip_ctx_t;
+
+static inline void transpose_conv_flip_task(void* arg, size_t begin, size_t end) {
+    const transpose_conv_flip_ctx_t* ctx = (const transpose_conv_flip_ctx_t*)arg;
+    size_t filter_bytes = ctx->in_per_group * ctx->kernel_size * ctx->element_size;
+    for (size_t item = begin; item < end; item++) {
+        size_t group = item / ctx->filters_per_group;
+        size_t filter = item % ctx->filters_per_group;
+        const char* src = ctx->src + (group * ctx->in_per_group * ctx->filters_per_group +
+                                      filter) * ctx->kernel_size * ctx->element_size;
+        char* dst = ctx->dst + item * filter_bytes;
+        transpose_2d_blocked(src, dst, ctx->in_per_group, ctx->kernel_size,
+                             ctx->filters_per_group * ctx->kernel_size, ctx->in_per_group,
+                             ctx->element_size, ctx->kernel, ctx->tile);
+        reverse_block_rows(dst, 1, ctx->kernel_size, ctx->in_per_group * ctx->element_size);
+    }
+}
+
+/**
+ * ONNX ConvTranspose weights to TFLite TRANSPOSE_CONV weights
+ * [C_in, C_out/g, kH, kW] -> [C_out, kH, kW, C_in/g]. Per group this is one
+ * (C_in/g) x (C_out/g * kH * kW) tiled transpose. With flip_spatial the
+ * kernel is also rotated by 180 degrees (kh -> kH-1-kh, kw -> kW-1-kw), as
+ * needed when a transposed convolution is lowered to a regular one; the
+ * flipped conversion transposes one filter at a time and reverses its
+ * kH*kW rows while they are in cache.
+ * @param onnx_data ONNX weight data pointer
+ * @param dims ONNX dimensions [C_in, C_out/g, kH, kW]
+ * @param groups Number of groups (ConvTranspose group attribute), must divide C_in
+ * @param flip_spatial Rotate each kernel by 180 degrees
+ * @param data_type Data type
+ * @return conversion_result_t Conversion result ([C_out, kH, kW, C_in/g], LAYOUT_OHWI)
+ */
+static inline conversion_result_t onnx_to_tflite_transpose_conv_weights(
+        const void* onnx_data, const int32_t* dims, size_t groups, bool flip_spatial,
+        tensor_data_type_t data_type) {
+    conversion_result_t result = {0};
+    size_t element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(onnx_data, dims, 4, data_type, &element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (groups == 0 || (size_t)dims[0] % groups != 0) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": %d input channels do not split into %zu groups",
+                dims[0], groups);
+        return result;
+    }
+    size_t out_channels = (size_t)dims[1] * groups;
+    if (out_channels > INT32_MAX) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": %zu output channels", out_channels);
+        return result;
+    }
+    size_t total_bytes = element_size * total_elements;
+    if (!allocate_conversion_result(&result, total_bytes, 4)) {
+        return result;
+    }
+
+    size_t in_per_group = (size_t)dims[0] / groups;
+    size_t kernel_size = (size_t)dims[2] * (size_t)dims[3];
+    if (flip_spatial && kernel_size > 1) {
+        transpose_conv_flip_ctx_t ctx;
+        ctx.src = (const char*)onnx_data;
+        ctx.dst = (char*)result.data;
+        ctx.filters_per_group = (size_t)dims[1];
+        ctx.in_per_group = in_per_group;
+        ctx.kernel_size = kernel_size;
+        ctx.element_size = element_size;
+        ctx.kernel = get_transpose_block_kernel(element_size);
+        ctx.tile = get_transpose_tile(element_size, 0);
+        parallel_for(transpose_conv_flip_task, &ctx, out_channels,
+                     total_bytes / TENSOR_CONVERTER_PARALLEL_GRAIN);
+    } else {
+        // [g, C_in/g, C_out/g * kH * kW] -> [g, C_out/g * kH * kW, C_in/g]
+        size_t extents[3] = {groups, in_per_group, (size_t)dims[1] * kernel_size};
+        size_t perm[3] = {0, 2, 1};
+        transpose_tensor_unchecked(onnx_data, result.data, extents, 3, perm, element_size);
+    }
+
+    result.shape.dims[0] = (int32_t)out_channels;
+    result.shape.dims[1] = dims[2];
+    result.shape.dims[2] = dims[3];
+    result.shape.dims[3] = (int32_t)in_per_group;
+    result.shape.num_dims = 4;
+    result.shape.data_type = data_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = LAYOUT_OHWI;
+    result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
+
+#if defined(TENSOR_CONVERTER_ENABLE_MMAP)
+/**
+ * Memory-mapped file region
+ */
+typedef struct {
+    void* base;         // Page-aligned mapping start
+    size_t length;      // Mapping length in bytes
+    void* data;         // Requested offset inside the mapping
+} tensor_file_map_t;
+
+/**
+ * Map a byte range of an open file
+ * The mapping starts at the page containing offset; map->data points at offset.
+ * @param fd Open file descriptor
+ * @param offset Byte offset of the range
+ * @param size Byte size of the range (> 0)
+ * @param writable Map read-write and shared (else read-only)
+ * @param map Output: mapping
+ * @return Returns true if successful, false otherwise (errno is set)
+ */
+static inline bool map_file_region(int fd, size_t offset, size_t size, bool writable,
+                                   tensor_file_map_t* map) {
+    long page_size = sysconf(_SC_PAGESIZE);
+    size_t page = page_size > 0 ? (size_t)page_size : 4096;
+    size_t aligned = offset / page * page;
+
+    map->length = offset - aligned + size;
+    map->base = mmap(NULL, map->length, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+                     MAP_SHARED, fd, (off_t)aligned);
+    if (map->base == MAP_FAILED) {
+        map->base = NULL;
+        map->data = NULL;
+        return false;
+    }
+    map->data = (char*)map->base + (offset - aligned);
+    // One front-to-back pass: read ahead aggressively, drop pages behind
+    posix_madvise(map->base, map->length, POSIX_MADV_SEQUENTIAL);
+    return true;
+}
+
+/**
+ * Unmap a file region mapped by map_file_region
+ * @param map Mapping (may be unmapped already)
+ */
+static inline void unmap_file_region(tensor_file_map_t* map) {
+    if (map->base) {
+        munmap(map->base, map->length);
+        map->base = NULL;
+        map->data = NULL;
+    }
+}
+
+/**
+ * Source and destination mappings of a file conversion
+ */
+typedef struct {
+    int src_fd;
+    int dst_fd;
+    tensor_file_map_t src_map;
+    tensor_file_map_t dst_map;
+} tensor_file_pair_t;
+
+/**
+ * Release the mappings and descriptors of a file conversion
+ * The destination mapping is flushed with msync first, so write-back errors
+ * (such as EIO) are reported instead of being lost at munmap.
+ * @param pair File pair (partially opened pairs are fine)
+ * @param error_msg Error message buffer, filled on failure (may be NULL)
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if the destination was written back, false otherwise
+ */
+static inline bool close_file_pair(tensor_file_pair_t* pair,
+                                   char* error_msg, size_t error_msg_size) {
+    bool ok = true;
+    if (pair->dst_map.base && msync(pair->dst_map.base, pair->dst_map.length, MS_SYNC) != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": msync: %s", strerror(errno));
+        ok = false;
+    }
+    unmap_file_region(&pair->dst_map);
+    unmap_file_region(&pair->src_map);
+    if (pair->dst_fd >= 0) {
+        if (close(pair->dst_fd) != 0 && ok) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_FILE_IO ": close: %s", strerror(errno));
+            ok = false;
+        }
+        pair->dst_fd = -1;
+    }
+    if (pair->src_fd >= 0) {
+        close(pair->src_fd);
+        pair->src_fd = -1;
+    }
+    return ok;
+}
+
+/**
+ * Map the source range read-only and create, size and map the destination file
+ * The caller releases the pair with close_file_pair on success and failure.
+ * @param pair Output: file pair (initialized here)
+ * @param src_path Source file path
+ * @param src_offset Byte offset of the tensor in the source file
+ * @param src_bytes Source tensor size in bytes
+ * @param dst_path Destination file path (created or truncated, not the source file)
+ * @param dst_bytes Destination tensor size in bytes
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool open_file_pair(tensor_file_pair_t* pair,
+                                  const char* src_path, size_t src_offset, size_t src_bytes,
+                                  const char* dst_path, size_t dst_bytes,
+                                  char* error_msg, size_t error_msg_size) {
+    struct stat st;
+    int err = 0;
+
+    memset(pair, 0, sizeof(*pair));
+    pair->dst_fd = -1;
+    pair->src_fd = open(src_path, O_RDONLY);
+    if (pair->src_fd < 0 || fstat(pair->src_fd, &st) != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: %s", src_path, strerror(errno));
+        return false;
+    }
+    if (src_offset > (size_t)st.st_size || (size_t)st.st_size - src_offset < src_bytes) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: need %zu bytes at offset %zu, file has %lld",
+                src_path, src_bytes, src_offset, (long long)st.st_size);
+        return false;
+    }
+    if (!map_file_region(pair->src_fd, src_offset, src_bytes, false, &pair->src_map)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": mmap %s: %s", src_path, strerror(errno));
+        return false;
+    }
+    // Opened without O_TRUNC: truncating before the identity check would wipe
+    // the source when both paths name the same file
+    struct stat dst_st;
+    pair->dst_fd = open(dst_path, O_RDWR | O_CREAT, 0644);
+    if (pair->dst_fd < 0 || fstat(pair->dst_fd, &dst_st) != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: %s", dst_path, strerror(errno));
+        return false;
+    }
+    if (dst_st.st_dev == st.st_dev && dst_st.st_ino == st.st_ino) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s and %s are the same file", src_path, dst_path);
+        return false;
+    }
+    if (ftruncate(pair->dst_fd, 0) != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": truncate %s: %s", dst_path, strerror(errno));
+        return false;
+    }
+    // Reserve the blocks up front: running out of space while writing
+    // through a mapping would raise SIGBUS instead of returning an error
+    err = posix_fallocate(pair->dst_fd, 0, (off_t)dst_bytes);
+    if (err != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": allocate %zu bytes for %s: %s",
+                dst_bytes, dst_path, strerror(err));
+        return false;
+    }
+    if (!map_file_region(pair->dst_fd, 0, dst_bytes, true, &pair->dst_map)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": mmap %s: %s", dst_path, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Convert a raw tensor file into another file through memory mappings
+ * The source range is mapped read-only and the destination file is created
+ * (or truncated), sized with posix_fallocate and mapped shared; the layout
+ * (and float32 <-> float16) kernels then run directly between the mappings.
+ * No user-space read buffer is used, so tensors larger than physical memory
+ * are converted through the page cache.
+ * @param src_path Source file path
+ * @param src_offset Byte offset of the tensor in the source file (element aligned)
+ * @param dst_path Destination file path (created or truncated, not the source file)
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param src_type Source data type
+ * @param dst_type Destination data type (equal to src_type, or the other of float32/float16)
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Result with the destination shape and size, no data
+ */
+static inline conversion_result_t convert_file(const char* src_path, size_t src_offset,
+                                               const char* dst_path,
+                                               const int32_t* dims, size_t num_dims,
+                                               tensor_data_type_t src_type,
+                                               tensor_data_type_t dst_type,
+                                               tensor_layout_t src_layout,
+                                               tensor_layout_t dst_layout) {
+    conversion_result_t result = {0};
+    size_t src_element_size = 0;
+    size_t total_elements = 0;
+    int cast = -1;
+
+    if (!src_path || !dst_path || !dims || num_dims == 0) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_NULL_POINTER);
+        return result;
+    }
+    if (!validate_conversion_shape(dims, num_dims, src_type, &src_element_size, &total_elements,
+                                   result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (src_type != dst_type) {
+        cast = get_cast_index(src_type, dst_type);
+        if (cast < 0) {
+            safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                    ERROR_MSG_UNSUPPORTED_TYPE ": from %d to %d", src_type, dst_type);
+            return result;
+        }
+    }
+    size_t dst_element_size = get_data_type_size(dst_type);
+    if (total_elements > SIZE_MAX / dst_element_size) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": size too large");
+        return result;
+    }
+    bool need_permute = false;
+    if (!check_fused_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                       result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (src_offset % src_element_size != 0) {
+        // Kernels load whole elements; a mapping cannot realign the data
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_FILE_IO ": offset %zu is not a multiple of the %zu-byte element size",
+                src_offset, src_element_size);
+        return result;
+    }
+    result.shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
+    if (!result.shape.dims) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_MEMORY_ALLOC);
+        return result;
+    }
+
+    size_t dst_bytes = dst_element_size * total_elements;
+    tensor_file_pair_t pair;
+    bool ok = open_file_pair(&pair, src_path, src_offset, src_element_size * total_elements,
+                             dst_path, dst_bytes, result.error_msg, sizeof(result.error_msg));
+    if (ok && cast < 0) {
+        ok = convert_layout_data(pair.src_map.data, dims, num_dims, src_element_size,
+                                 total_elements, src_layout, dst_layout, pair.dst_map.data,
+                                 result.shape.dims, result.error_msg, sizeof(result.error_msg));
+    } else if (ok) {
+        convert_layout_cast_data(pair.src_map.data, pair.dst_map.data, dims, num_dims,
+                                 total_elements, src_layout, dst_layout, need_permute,
+                                 (tensor_cast_t)cast, src_element_size, dst_element_size,
+                                 result.shape.dims);
+    }
+    // Report write-back failures unless an earlier step already failed
+    if (!close_file_pair(&pair, ok ? result.error_msg : NULL, sizeof(result.error_msg))) {
+        ok = false;
+    }
+    if (!ok) {
+        free(result.shape.dims);
+        result.shape.dims = NULL;
+        return result;
+    }
+
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = dst_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+    result.data_size = dst_bytes;
+    result.success = true;
+    return result;
+}
+#endif // TENSOR_CONVERTER_ENABLE_MMAP
+
+/**
+ * ONNX TensorProto fields used by the decoder
+ */
+typedef enum {
+    ONNX_TENSOR_FIELD_DIMS = 1,
+    ONNX_TENSOR_FIELD_DATA_TYPE = 2,
+    ONNX_TENSOR_FIELD_SEGMENT = 3,
+    ONNX_TENSOR_FIELD_FLOAT_DATA = 4,
+    ONNX_TENSOR_FIELD_INT32_DATA = 5,
+    ONNX_TENSOR_FIELD_STRING_DATA = 6,
+    ONNX_TENSOR_FIELD_INT64_DATA = 7,
+    ONNX_TENSOR_FIELD_NAME = 8,
+    ONNX_TENSOR_FIELD_RAW_DATA = 9,
+    ONNX_TENSOR_FIELD_DOUBLE_DATA = 10,
+    ONNX_TENSOR_FIELD_UINT64_DATA = 11,
+    ONNX_TENSOR_FIELD_EXTERNAL_DATA = 13,
+    ONNX_TENSOR_FIELD_DATA_LOCATION = 14
+} onnx_tensor_field_t;
+
+/**
+ * Protobuf wire types
+ */
+typedef enum {
+    PROTO_WIRE_VARINT = 0,
+    PROTO_WIRE_FIXED64 = 1,
+    PROTO_WIRE_LENGTH = 2,
+    PROTO_WIRE_FIXED32 = 5
+} proto_wire_type_t;
+
+/**
+ * Zero-copy view of a serialized ONNX TensorProto
+ * Pointers reference the serialized buffer, which must outlive the view.
+ */
+typedef struct {
+    const char* name;               // Tensor name (not NUL-terminated), NULL if absent
+    size_t name_size;
+    int32_t dims[TENSOR_MAX_DIMS];
+    size_t num_dims;
+    int32_t onnx_type;              // TensorProto.DataType value
+    tensor_data_type_t data_type;   // Matching converter type
+    const void* data;               // Little-endian element data (may be unaligned), NULL if external
+    size_t data_size;               // Data size in bytes
+    bool is_external;               // data_location == EXTERNAL
+    const char* location;           // external_data "location" (not NUL-terminated), NULL if absent
+    size_t location_size;
+    uint64_t external_offset;       // external_data "offset", 0 if absent
+    uint64_t external_length;       // external_data "length", 0 if absent
+} onnx_tensor_view_t;
+
+/**
+ * Read a protobuf varint
+ * @param ptr In/out: read position
+ * @param end End of the buffer
+ * @param value Output: decoded value
+ * @return Returns true if successful, false on truncated or overlong input
+ */
+static inline bool read_proto_varint(const uint8_t** ptr, const uint8_t* end, uint64_t* value) {
+    uint64_t result = 0;
+    const uint8_t* p = *ptr;
+    for (unsigned shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        result |= (uint64_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *ptr = p;
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Read a protobuf field value, skipping or returning it by wire type
+ * @param ptr In/out: read position (after the tag)
+ * @param end End of the buffer
+ * @param wire_type Wire type of the field
+ * @param value Output: varint value (PROTO_WIRE_VARINT)
+ * @param bytes Output: payload start (PROTO_WIRE_LENGTH), NULL otherwise
+ * @param size Output: payload size in bytes (PROTO_WIRE_LENGTH)
+ * @return Returns true if successful, false on malformed input
+ */
+static inline bool read_proto_field(const uint8_t** ptr, const uint8_t* end, uint32_t wire_type,
+                                    uint64_t* value, const uint8_t** bytes, size_t* size) {
+    *bytes = NULL;
+    *size = 0;
+    switch (wire_type) {
+    case PROTO_WIRE_VARINT:
+        return read_proto_varint(ptr, end, value);
+    case PROTO_WIRE_FIXED64:
+    case PROTO_WIRE_FIXED32: {
+        size_t width = wire_type == PROTO_WIRE_FIXED64 ? 8 : 4;
+        if ((size_t)(end - *ptr) < width) {
+            return false;
+        }
+        *ptr += width;
+        return true;
+    }
+    case PROTO_WIRE_LENGTH: {
+        uint64_t length = 0;
+        if (!read_proto_varint(ptr, end, &length) || length > (uint64_t)(end - *ptr)) {
+            return false;
+        }
+        *bytes = *ptr;
+        *size = (size_t)length;
+        *ptr += length;
+        return true;
+    }
+    default:
+        return false;   // Groups are not used by ONNX
+    }
+}
+
+/**
+ * Map an ONNX TensorProto.DataType to a converter data type
+ * @param onnx_type TensorProto.DataType value
+ * @param data_type Output: converter data type
+ * @return Returns true if the type is supported, false otherwise
+ */
+static inline bool get_onnx_data_type(int32_t onnx_type, tensor_data_type_t* data_type) {
+    switch (onnx_type) {
+    case 1: *data_type = TENSOR_FLOAT32; return true;     // FLOAT
+    case 2: *data_type = TENSOR_UINT8; return true;       // UINT8
+    case 3: *data_type = TENSOR_INT8; return true;        // INT8
+    case 5: *data_type = TENSOR_INT16; return true;       // INT16
+    case 6: *data_type = TENSOR_INT32; return true;       // INT32
+    case 7: *data_type = TENSOR_INT64; return true;       // INT64
+    case 10: *data_type = TENSOR_FLOAT16; return true;    // FLOAT16
+    default: return false;
+    }
+}
+
+/**
+ * Append a decoded dimension to a tensor view
+ * @param view Tensor view
+ * @param value Dimension value
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false if out of range or too many dims
+ */
+static inline bool append_onnx_dim(onnx_tensor_view_t* view, uint64_t value,
+                                   char* error_msg, size_t error_msg_size) {
+    if (view->num_dims >= TENSOR_MAX_DIMS || value == 0 || value > INT32_MAX) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_DIMS ": dim %zu = %llu", view->num_dims,
+                (unsigned long long)value);
+        return false;
+    }
+    view->dims[view->num_dims++] = (int32_t)value;
+    return true;
+}
+
+/**
+ * Parse an unsigned decimal string (external_data offset and length values)
+ * @param str String bytes (not NUL-terminated)
+ * @param length String length
+ * @param value Output: parsed value
+ * @return Returns true if successful, false on empty, non-digit or overflowing input
+ */
+static inline bool parse_proto_decimal(const uint8_t* str, size_t length, uint64_t* value) {
+    uint64_t result = 0;
+    if (length == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (str[i] < '0' || str[i] > '9' || result > (UINT64_MAX - (str[i] - '0')) / 10) {
+            return false;
+        }
+        result = result * 10 + (uint64_t)(str[i] - '0');
+    }
+    *value = result;
+    return true;
+}
+
+/**
+ * Decode one external_data key/value entry (StringStringEntryProto) into a view
+ * Keys other than location, offset and length (e.g. checksum) are ignored.
+ * @param entry Serialized entry
+ * @param size Entry size in bytes
+ * @param view Tensor view
+ * @return Returns true if successful, false on malformed input
+ */
+static inline bool decode_onnx_external_entry(const uint8_t* entry, size_t size,
+                                              onnx_tensor_view_t* view) {
+    const uint8_t* ptr = entry;
+    const uint8_t* end = entry + size;
+    const uint8_t* key = NULL;
+    const uint8_t* value = NULL;
+    size_t key_size = 0, value_size = 0;
+
+    while (ptr < end) {
+        uint64_t tag = 0, number = 0;
+        const uint8_t* bytes = NULL;
+        size_t length = 0;
+        if (!read_proto_varint(&ptr, end, &tag) ||
+            !read_proto_field(&ptr, end, (uint32_t)(tag & 7), &number, &bytes, &length)) {
+            return false;
+        }
+        if (bytes && (tag >> 3) == 1) {
+            key = bytes;
+            key_size = length;
+        } else if (bytes && (tag >> 3) == 2) {
+            value = bytes;
+            value_size = length;
+        }
+    }
+    if (!key || !value) {
+        return true;
+    }
+    if (key_size == 8 && memcmp(key, "location", 8) == 0) {
+        view->location = (const char*)value;
+        view->location_size = value_size;
+        return true;
+    }
+    if (key_size == 6 && memcmp(key, "offset", 6) == 0) {
+        return parse_proto_decimal(value, value_size, &view->external_offset);
+    }
+    if (key_size == 6 && memcmp(key, "length", 6) == 0) {
+        return parse_proto_decimal(value, value_size, &view->external_length);
+    }
+    return true;
+}
+
+/**
+ * Compute the data size in bytes that a decoded tensor view's shape needs
+ * @param view Tensor view
+ * @param data_size Output: data size in bytes
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false on overflow
+ */
+static inline bool get_onnx_view_data_size(const onnx_tensor_view_t* view, size_t* data_size,
+                                           char* error_msg, size_t error_msg_size) {
+    size_t expected = get_data_type_size(view->data_type);
+    for (size_t i = 0; i < view->num_dims; i++) {
+        if (expected > SIZE_MAX / (size_t)view->dims[i]) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_DIMS ": size too large");
+            return false;
+        }
+        expected *= (size_t)view->dims[i];
+    }
+    *data_size = expected;
+    return true;
+}
+
+/**
+ * Decode a serialized ONNX TensorProto without copying or allocating
+ * Reads dims, data_type, name, data_location, external_data and the element
+ * data from raw_data or packed float_data (both little-endian in the wire format).
+ * float_data is only accepted for FLOAT tensors. Other typed data fields need
+ * per-element varint decoding and are rejected.
+ * @param buffer Serialized TensorProto
+ * @param size Buffer size in bytes
+ * @param view Output: tensor view into buffer
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool decode_onnx_tensor_proto(const void* buffer, size_t size,
+                                            onnx_tensor_view_t* view,
+                                            char* error_msg, size_t error_msg_size) {
+    const uint8_t* ptr = (const uint8_t*)buffer;
+    const uint8_t* end = ptr + size;
+    bool has_type = false;
+    bool has_float_data = false;    // data came from float_data rather than raw_data
+
+    if (!buffer || !view) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    (void)end;
+    (void)has_type;
+    (void)has_float_data;
+    safe_snprintf(error_msg, error_msg_size,
+            ERROR_MSG_INVALID_PROTO ": big-endian hosts need a byte-swapping copy");
+    return false;
+#else
+    memset(view, 0, sizeof(*view));
+    while (ptr < end) {
+        uint64_t tag = 0, value = 0;
+        const uint8_t* bytes = NULL;
+        size_t length = 0;
+        if (!read_proto_varint(&ptr, end, &tag) ||
+            !read_proto_field(&ptr, end, (uint32_t)(tag & 7), &value, &bytes, &length)) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_PROTO ": truncated or malformed field %llu",
+                    (unsigned long long)(tag >> 3));
+            return false;
+        }
+
+        switch (tag >> 3) {
+        case ONNX_TENSOR_FIELD_DIMS:
+            if (!bytes) {
+                if (!append_onnx_dim(view, value, error_msg, error_msg_size)) {
+                    return false;
+                }
+                break;
+            }
+            // Packed dims
+            for (const uint8_t* dim_ptr = bytes; dim_ptr < bytes + length;) {
+                if (!read_proto_varint(&dim_ptr, bytes + length, &value)) {
+                    safe_snprintf(error_msg, error_msg_size,
+                            ERROR_MSG_INVALID_PROTO ": malformed dims");
+                    return false;
+                }
+                if (!append_onnx_dim(view, value, error_msg, error_msg_size)) {
+                    return false;
+                }
+            }
+            break;
+        case ONNX_TENSOR_FIELD_DATA_TYPE:
+            view->onnx_type = (int32_t)value;
+            has_type = true;
+            break;
+        case ONNX_TENSOR_FIELD_SEGMENT:
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_PROTO ": segmented tensors are not supported");
+            return false;
+        case ONNX_TENSOR_FIELD_FLOAT_DATA:
+        case ONNX_TENSOR_FIELD_RAW_DATA:
+            if (!bytes) {
+                safe_snprintf(error_msg, error_msg_size,
+                        ERROR_MSG_INVALID_PROTO ": unpacked float_data is not supported");
+                return false;
+            }
+            view->data = bytes;
+            view->data_size = length;
+            has_float_data = (tag >> 3) == ONNX_TENSOR_FIELD_FLOAT_DATA;
+            break;
+        case ONNX_TENSOR_FIELD_NAME:
+            view->name = (const char*)bytes;
+            view->name_size = length;
+            break;
+        case ONNX_TENSOR_FIELD_DATA_LOCATION:
+            view->is_external = value == 1;
+            break;
+        case ONNX_TENSOR_FIELD_EXTERNAL_DATA:
+            if (!bytes || !decode_onnx_external_entry(bytes, length, view)) {
+                safe_snprintf(error_msg, error_msg_size,
+                        ERROR_MSG_INVALID_PROTO ": malformed external_data entry");
+                return false;
+            }
+            break;
+        case ONNX_TENSOR_FIELD_INT32_DATA:
+        case ONNX_TENSOR_FIELD_STRING_DATA:
+        case ONNX_TENSOR_FIELD_INT64_DATA:
+        case ONNX_TENSOR_FIELD_DOUBLE_DATA:
+        case ONNX_TENSOR_FIELD_UINT64_DATA:
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_PROTO ": typed data field %llu is not supported",
+                    (unsigned long long)(tag >> 3));
+            return false;
+        default:
+            break;          // doc_string, metadata, ...
+        }
+    }
+
+    if (!has_type || !get_onnx_data_type(view->onnx_type, &view->data_type)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_UNSUPPORTED_TYPE ": ONNX data_type %d", view->onnx_type);
+        return false;
+    }
+    if (view->num_dims == 0) {
+        // Scalar tensor
+        view->dims[0] = 1;
+        view->num_dims = 1;
+    }
+    if (view->is_external) {
+        view->data = NULL;
+        view->data_size = 0;
+        return true;
+    }
+    // Fields may come in any order, so the type is only known after the loop
+    if (has_float_data && view->data_type != TENSOR_FLOAT32) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_PROTO ": float_data for ONNX data_type %d", view->onnx_type);
+        return false;
+    }
+    size_t expected = 0;
+    if (!get_onnx_view_data_size(view, &expected, error_msg, error_msg_size)) {
+        return false;
+    }
+    if (!view->data || view->data_size != expected) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_PROTO ": data is %zu bytes, shape needs %zu",
+                view->data_size, expected);
+        return false;
+    }
+    return true;
+#endif
+}
+
+/**
+ * Convert tensor data that may not be aligned to its element size
+ * Model files only guarantee byte alignment for embedded tensor data.
+ * Aligned data is converted in place; unaligned data is first copied to an
+ * aligned buffer (see get_aligned_source).
+ * @param data Source data pointer
+ * @param data_size Source data size in bytes
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t convert_tensor_realigned(const void* data, size_t data_size,
+                                                           const int32_t* dims, size_t num_dims,
+                                                           tensor_data_type_t data_type,
+                                                           tensor_layout_t src_layout,
+                                                           tensor_layout_t dst_layout) {
+    conversion_result_t result = {0};
+    void* copy = NULL;
+    const void* src = get_aligned_source(data, data_size, get_data_type_size(data_type), &copy,
+                                         result.error_msg, sizeof(result.error_msg));
+    if (!src) {
+        return result;
+    }
+    result = convert_tensor_alloc(src, dims, num_dims, data_type, src_layout, dst_layout, 0);
+    free(copy);
+    return result;
+}
+
+/**
+ * Decode a serialized ONNX TensorProto and convert it for TFLite
+ * The tensor data is read in place from the serialized buffer (see
+ * convert_tensor_realigned for unaligned data).
+ * @param proto Serialized TensorProto
+ * @param proto_size Buffer size in bytes
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_from_tensor_proto(const void* proto,
+                                                                   size_t proto_size,
+                                                                   tensor_layout_t src_layout,
+                                                                   tensor_layout_t dst_layout) {
+    conversion_result_t result = {0};
+    onnx_tensor_view_t view;
+
+    if (!decode_onnx_tensor_proto(proto, proto_size, &view,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (view.is_external) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_PROTO ": tensor data is stored externally");
+        return result;
+    }
+    return convert_tensor_realigned(view.data, view.data_size, view.dims, view.num_dims,
+                                    view.data_type, src_layout, dst_layout);
+}
+
+#if defined(TENSOR_CONVERTER_ENABLE_MMAP)
+/**
+ * External data file shared by the tensors that reference it
+ */
+typedef struct {
+    char* location;             // external_data "location" (NUL-terminated copy)
+    tensor_file_map_t map;      // Read-only mapping of the whole file
+    size_t size;                // File size in bytes
+} onnx_external_file_t;
+
+/**
+ * Resolver for ONNX external tensor data
+ * Each referenced file is mapped once on first use and shared by every
+ * tensor stored in it; resolved views point into the mappings, which stay
+ * valid until close_onnx_external_data.
+ */
+typedef struct {
+    char* base_dir;                 // Directory of the model file
+    onnx_external_file_t* files;
+    size_t num_files;
+    size_t capacity;
+} onnx_external_data_t;
+
+/**
+ * Initialize an external data resolver
+ * @param ext Resolver to initialize
+ * @param base_dir Directory that locations are relative to (NULL: current directory)
+ * @return Returns true if successful, false on allocation failure
+ */
+static inline bool open_onnx_external_data(onnx_external_data_t* ext, const char* base_dir) {
+    if (!ext) {
+        return false;
+    }
+    memset(ext, 0, sizeof(*ext));
+    if (base_dir && base_dir[0] != '\0') {
+        size_t length = strlen(base_dir);
+        ext->base_dir = (char*)malloc(length + 1);
+        if (!ext->base_dir) {
+            return false;
+        }
+        memcpy(ext->base_dir, base_dir, length + 1);
+    }
+    return true;
+}
+
+/**
+ * Unmap all files of an external data resolver
+ * Views resolved through it become invalid.
+ * @param ext Resolver (may be closed already)
+ */
+static inline void close_onnx_external_data(onnx_external_data_t* ext) {
+    if (!ext) {
+        return;
+    }
+    for (size_t i = 0; i < ext->num_files; i++) {
+        unmap_file_region(&ext->files[i].map);
+        free(ext->files[i].location);
+    }
+    free(ext->files);
+    free(ext->base_dir);
+    memset(ext, 0, sizeof(*ext));
+}
+
+/**
+ * Check that an external data location stays inside the model directory
+ * ONNX requires relative locations without ".." components.
+ * @param location Location string (not NUL-terminated)
+ * @param length Location length
+ * @return Returns true if the location is acceptable, false otherwise
+ */
+static inline bool is_valid_onnx_location(const char* location, size_t length) {
+    if (!location || length == 0 || location[0] == '/' || memchr(location, '\0', length)) {
+        return false;
+    }
+    for (size_t begin = 0; begin < length;) {
+        size_t end = begin;
+        while (end < length && location[end] != '/') {
+            end++;
+        }
+        if (end - begin == 2 && location[begin] == '.' && location[begin + 1] == '.') {
+            return false;
+        }
+        begin = end + 1;
+    }
+    return true;
+}
+
+/**
+ * Find or map the external data file for a location
+ * @param ext Resolver
+ * @param location Location string (not NUL-terminated, validated)
+ * @param length Location length
+ * @param file Output: shared file entry
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool get_onnx_external_file(onnx_external_data_t* ext,
+                                          const char* location, size_t length,
+                                          const onnx_external_file_t** file,
+                                          char* error_msg, size_t error_msg_size) {
+    for (size_t i = 0; i < ext->num_files; i++) {
+        if (strlen(ext->files[i].location) == length &&
+            memcmp(ext->files[i].location, location, length) == 0) {
+            *file = &ext->files[i];
+            return true;
+        }
+    }
+
+    if (ext->num_files == ext->capacity) {
+        size_t capacity = ext->capacity ? ext->capacity * 2 : 4;
+        onnx_external_file_t* files = (onnx_external_file_t*)realloc(
+                ext->files, capacity * sizeof(*files));
+        if (!files) {
+            safe_snprintf(error_msg, error_msg_size, ERROR_MSG_MEMORY_ALLOC);
+            return false;
+        }
+        ext->files = files;
+        ext->capacity = capacity;
+    }
+
+    size_t dir_length = ext->base_dir ? strlen(ext->base_dir) : 0;
+    char* path = (char*)malloc(dir_length + 1 + length + 1);
+    char* name = (char*)malloc(length + 1);
+    if (!path || !name) {
+        free(path);
+        free(name);
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_MEMORY_ALLOC);
+        return false;
+    }
+    memcpy(name, location, length);
+    name[length] = '\0';
+    if (dir_length > 0) {
+        memcpy(path, ext->base_dir, dir_length);
+        path[dir_length] = '/';
+        memcpy(path + dir_length + 1, name, length + 1);
+    } else {
+        memcpy(path, name, length + 1);
+    }
+
+    onnx_external_file_t entry;
+    struct stat st;
+    bool ok = false;
+    memset(&entry, 0, sizeof(entry));
+    entry.location = name;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: %s", path, strerror(errno));
+    } else if (st.st_size <= 0 || (uint64_t)st.st_size > SIZE_MAX) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: unsupported file size %lld",
+                path, (long long)st.st_size);
+    } else if (!map_file_region(fd, 0, (size_t)st.st_size, false, &entry.map)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": mmap %s: %s", path, strerror(errno));
+    } else {
+        // Tensors are read in any order; undo the sequential hint
+        posix_madvise(entry.map.base, entry.map.length, POSIX_MADV_NORMAL);
+        entry.size = (size_t)st.st_size;
+        ok = true;
+    }
+    if (fd >= 0) {
+        close(fd);      // The mapping keeps the file referenced
+    }
+    free(path);
+    if (!ok) {
+        free(name);
+        return false;
+    }
+    ext->files[ext->num_files] = entry;
+    *file = &ext->files[ext->num_files++];
+    return true;
+}
+
+/**
+ * Point an externally stored tensor view at its data in the mapped file
+ * Views with in-proto data are left unchanged. On success view->data points
+ * into the shared mapping (no copy) and view->data_size matches the shape.
+ * @param ext Resolver
+ * @param view Decoded tensor view (see decode_onnx_tensor_proto)
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful, false otherwise
+ */
+static inline bool resolve_onnx_external_data(onnx_external_data_t* ext,
+                                              onnx_tensor_view_t* view,
+                                              char* error_msg, size_t error_msg_size) {
+    const onnx_external_file_t* file = NULL;
+    size_t expected = 0;
+
+    if (!ext || !view) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+    if (!view->is_external) {
+        return true;
+    }
+    if (!is_valid_onnx_location(view->location, view->location_size)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_PROTO ": missing or unsafe external data location");
+        return false;
+    }
+    if (!get_onnx_view_data_size(view, &expected, error_msg, error_msg_size)) {
+        return false;
+    }
+    if (view->external_length != 0 && view->external_length != (uint64_t)expected) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_PROTO ": external length %llu, shape needs %zu",
+                (unsigned long long)view->external_length, expected);
+        return false;
+    }
+    if (!get_onnx_external_file(ext, view->location, view->location_size, &file,
+                                error_msg, error_msg_size)) {
+        return false;
+    }
+    if (view->external_offset > (uint64_t)file->size ||
+        file->size - (size_t)view->external_offset < expected) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_FILE_IO ": %s: need %zu bytes at offset %llu, file has %zu",
+                file->location, expected, (unsigned long long)view->external_offset,
+                file->size);
+        return false;
+    }
+    view->data = (const char*)file->map.data + view->external_offset;
+    view->data_size = expected;
+    return true;
+}
+
+/**
+ * Decode a serialized ONNX TensorProto, resolving external data, and convert it for TFLite
+ * External data is read straight from the shared file mapping.
+ * @param ext External data resolver
+ * @param proto Serialized TensorProto
+ * @param proto_size Buffer size in bytes
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_from_external_tensor_proto(
+        onnx_external_data_t* ext, const void* proto, size_t proto_size,
+        tensor_layout_t src_layout, tensor_layout_t dst_layout) {
+    conversion_result_t result = {0};
+    onnx_tensor_view_t view;
+
+    if (!decode_onnx_tensor_proto(proto, proto_size, &view,
+                                  result.error_msg, sizeof(result.error_msg)) ||
+        !resolve_onnx_external_data(ext, &view, result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    return convert_tensor_realigned(view.data, view.data_size, view.dims, view.num_dims,
+                                    view.data_type, src_layout, dst_layout);
+}
+#endif // TENSOR_CONVERTER_ENABLE_MMAP
+
+/**
+ * Bounds-checked reader over a little-endian flatbuffer
+ */
+typedef struct {
+    const uint8_t* base;
+    size_t size;
+} flatbuffer_reader_t;
+
+static inline bool read_fb_u32(const flatbuffer_reader_t* fb, size_t pos, uint32_t* value) {
+    if (pos > fb->size || fb->size - pos < 4) {
+        return false;
+    }
+    memcpy(value, fb->base + pos, 4);
+    return true;
+}
+
+static inline bool read_fb_u64(const flatbuffer_reader_t* fb, size_t pos, uint64_t* value) {
+    if (pos > fb->size || fb->size - pos < 8) {
+        return false;
+    }
+    memcpy(value, fb->base + pos, 8);
+    return true;
+}
+
+/**
+ * Locate a table field through the table's vtable
+ * @param fb Flatbuffer reader
+ * @param table Table position
+ * @param field Field index in schema order
+ * @param pos Output: field position, 0 if the field is absent
+ * @return Returns true if successful, false on out-of-bounds offsets
+ */
+static inline bool find_fb_field(const flatbuffer_reader_t* fb, size_t table, size_t field,
+                                 size_t* pos) {
+    uint32_t raw = 0;
+    uint16_t vtable_size = 0, field_offset = 0;
+    if (!read_fb_u32(fb, table, &raw)) {
+        return false;
+    }
+    // soffset_t: the vtable lives at table - soffset
+    int64_t vtable = (int64_t)table - (int64_t)(int32_t)raw;
+    if (vtable < 0 || (uint64_t)vtable > fb->size || fb->size - (size_t)vtable < 4) {
+        return false;
+    }
+    memcpy(&vtable_size, fb->base + vtable, 2);
+    *pos = 0;
+    if (4 + 2 * field + 2 > vtable_size) {
+        return true;
+    }
+    if ((size_t)vtable + 4 + 2 * field + 2 > fb->size) {
+        return false;
+    }
+    memcpy(&field_offset, fb->base + vtable + 4 + 2 * field, 2);
+    if (field_offset != 0) {
+        *pos = table + field_offset;
+    }
+    return true;
+}
+
+/**
+ * Follow a uoffset_t field to the table, vector or string it references
+ * @param fb Flatbuffer reader
+ * @param pos Field position
+ * @param target Output: referenced position
+ * @return Returns true if successful, false on out-of-bounds offsets
+ */
+static inline bool follow_fb_offset(const flatbuffer_reader_t* fb, size_t pos, size_t* target) {
+    uint32_t offset = 0;
+    if (!read_fb_u32(fb, pos, &offset) || offset > fb->size - pos) {
+        return false;
+    }
+    *target = pos + offset;
+    return true;
+}
+
+/**
+ * Resolve an optional vector field of a table
+ * @param fb Flatbuffer reader
+ * @param table Table position
+ * @param field Field index in schema order
+ * @param element_size Vector element byte size
+ * @param elements Output: first element position
+ * @param count Output: element count, 0 if the field is absent
+ * @return Returns true if successful, false on out-of-bounds data
+ */
+static inline bool find_fb_vector(const flatbuffer_reader_t* fb, size_t table, size_t field,
+                                  size_t element_size, size_t* elements, size_t* count) {
+    size_t pos = 0, vector = 0;
+    uint32_t length = 0;
+    *elements = 0;
+    *count = 0;
+    if (!find_fb_field(fb, table, field, &pos)) {
+        return false;
+    }
+    if (pos == 0) {
+        return true;
+    }
+    if (!follow_fb_offset(fb, pos, &vector) || !read_fb_u32(fb, vector, &length) ||
+        (size_t)length > (fb->size - vector - 4) / element_size) {
+        return false;
+    }
+    *elements = vector + 4;
+    *count = length;
+    return true;
+}
+
+/**
+ * TFLite schema field indices used by the walker
+ */
+typedef enum {
+    TFLITE_MODEL_SUBGRAPHS = 2,
+    TFLITE_MODEL_BUFFERS = 4,
+    TFLITE_SUBGRAPH_TENSORS = 0,
+    TFLITE_TENSOR_SHAPE = 0,
+    TFLITE_TENSOR_TYPE = 1,
+    TFLITE_TENSOR_BUFFER = 2,
+    TFLITE_TENSOR_NAME = 3,
+    TFLITE_BUFFER_DATA = 0,
+    TFLITE_BUFFER_OFFSET = 1,
+    TFLITE_BUFFER_SIZE = 2
+} tflite_schema_field_t;
+
+/**
+ * Zero-copy view of a tensor in a TFLite model
+ * Pointers reference the model buffer, which must outlive the view.
+ */
+typedef struct {
+    uint32_t subgraph;              // Subgraph index
+    uint32_t index;                 // Tensor index in the subgraph
+    const char* name;               // Tensor name (not NUL-terminated), NULL if absent
+    size_t name_size;
+    int32_t dims[TENSOR_MAX_DIMS];
+    size_t num_dims;
+    int8_t tflite_type;             // TensorType value
+    bool type_supported;            // data_type is valid
+    tensor_data_type_t data_type;   // Matching converter type
+    uint32_t buffer;                // Buffer index (0: no data)
+    const void* data;               // Constant data in the model (may be unaligned), NULL if none
+    size_t data_size;
+} tflite_tensor_view_t;
+
+/**
+ * Tensor callback of the model walker
+ * @param tensor Tensor view, valid until the callback returns
+ * @param user_data User pointer passed to the walker
+ * @return Returns true to continue, false to stop the walk
+ */
+typedef bool (*tflite_tensor_fn)(const tflite_tensor_view_t* tensor, void* user_data);
+
+/**
+ * Map a TFLite TensorType to a converter data type
+ * @param tflite_type TensorType value
+ * @param data_type Output: converter data type
+ * @return Returns true if the type is supported, false otherwise
+ */
+static inline bool get_tflite_data_type(int8_t tflite_type, tensor_data_type_t* data_type) {
+    switch (tflite_type) {
+    case 0: *data_type = TENSOR_FLOAT32; return true;     // FLOAT32
+    case 1: *data_type = TENSOR_FLOAT16; return true;     // FLOAT16
+    case 2: *data_type = TENSOR_INT32; return true;       // INT32
+    case 3: *data_type = TENSOR_UINT8; return true;       // UINT8
+    case 4: *data_type = TENSOR_INT64; return true;       // INT64
+    case 7: *data_type = TENSOR_INT16; return true;       // INT16
+    case 9: *data_type = TENSOR_INT8; return true;        // INT8
+    default: return false;
+    }
+}
+
+/**
+ * Resolve the data of a model buffer
+ * Small models embed it in Buffer.data; models over 2 GB store it after the
+ * flatbuffer and record its absolute file offset and size.
+ */
+static inline bool read_tflite_buffer(const flatbuffer_reader_t* fb, size_t buffers,
+                                      size_t num_buffers, uint32_t index,
+                                      const void** data, size_t* data_size) {
+    size_t buffer = 0, elements = 0, count = 0, pos = 0;
+    *data = NULL;
+    *data_size = 0;
+    if (index == 0) {
+        return true;
+    }
+    if (index >= num_buffers || !follow_fb_offset(fb, buffers + 4 * (size_t)index, &buffer) ||
+        !find_fb_vector(fb, buffer, TFLITE_BUFFER_DATA, 1, &elements, &count)) {
+        return false;
+    }
+    if (count > 0) {
+        *data = fb->base + elements;
+        *data_size = count;
+        return true;
+    }
+
+    uint64_t offset = 0, size = 0;
+    if (!find_fb_field(fb, buffer, TFLITE_BUFFER_OFFSET, &pos)) {
+        return false;
+    }
+    if (pos != 0 && !read_fb_u64(fb, pos, &offset)) {
+        return false;
+    }
+    if (!find_fb_field(fb, buffer, TFLITE_BUFFER_SIZE, &pos)) {
+        return false;
+    }
+    if (pos != 0 && !read_fb_u64(fb, pos, &size)) {
+        return false;
+    }
+    if (offset > 1 && size > 0) {
+        // 1 is the writer's placeholder for "not yet placed"
+        if (offset > fb->size || size > fb->size - offset) {
+            return false;
+        }
+        *data = fb->base + offset;
+        *data_size = (size_t)size;
+    }
+    return true;
+}
+
+/**
+ * Walk every tensor of a TFLite model without copying
+ * Yields shape, type, name and constant data of each tensor in each
+ * subgraph. All offsets are bounds-checked against size, so the model may
+ * come straight from an untrusted file mapping.
+ * @param model Model buffer (.tflite file contents)
+ * @param size Model buffer size in bytes
+ * @param callback Tensor callback
+ * @param user_data User pointer passed to the callback
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if the whole model was walked (or the callback stopped it)
+ */
+static inline bool walk_tflite_model(const void* model, size_t size,
+                                     tflite_tensor_fn callback, void* user_data,
+                                     char* error_msg, size_t error_msg_size) {
+    if (!model || !callback) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    (void)size;
+    (void)user_data;
+    safe_snprintf(error_msg, error_msg_size,
+            ERROR_MSG_INVALID_TFLITE ": big-endian hosts are not supported");
+    return false;
+#else
+    flatbuffer_reader_t fb;
+    size_t root = 0, subgraphs = 0, num_subgraphs = 0, buffers = 0, num_buffers = 0;
+
+    fb.base = (const uint8_t*)model;
+    fb.size = size;
+    if (size < 8 || memcmp(fb.base + 4, "TFL3", 4) != 0 || !follow_fb_offset(&fb, 0, &root) ||
+        !find_fb_vector(&fb, root, TFLITE_MODEL_SUBGRAPHS, 4, &subgraphs, &num_subgraphs) ||
+        !find_fb_vector(&fb, root, TFLITE_MODEL_BUFFERS, 4, &buffers, &num_buffers)) {
+        safe_snprintf(error_msg, error_msg_size,
+                ERROR_MSG_INVALID_TFLITE ": bad header or model table");
+        return false;
+    }
+
+    for (size_t g = 0; g < num_subgraphs; g++) {
+        size_t subgraph = 0, tensors = 0, num_tensors = 0;
+        if (!follow_fb_offset(&fb, subgraphs + 4 * g, &subgraph) ||
+            !find_fb_vector(&fb, subgraph, TFLITE_SUBGRAPH_TENSORS, 4, &tensors, &num_tensors)) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_TFLITE ": bad subgraph %zu", g);
+            return false;
+        }
+        for (size_t t = 0; t < num_tensors; t++) {
+            tflite_tensor_view_t view;
+            size_t tensor = 0, shape = 0, pos = 0, name = 0;
+            uint32_t buffer = 0;
+
+            memset(&view, 0, sizeof(view));
+            view.subgraph = (uint32_t)g;
+            view.index = (uint32_t)t;
+            bool ok = follow_fb_offset(&fb, tensors + 4 * t, &tensor) &&
+                      find_fb_vector(&fb, tensor, TFLITE_TENSOR_SHAPE, 4, &shape, &view.num_dims);
+            if (ok && view.num_dims > TENSOR_MAX_DIMS) {
+                safe_snprintf(error_msg, error_msg_size,
+                        ERROR_MSG_INVALID_DIMS ": tensor %zu of subgraph %zu has %zu dims",
+                        t, g, view.num_dims);
+                return false;
+            }
+            for (size_t i = 0; ok && i < view.num_dims; i++) {
+                uint32_t dim = 0;
+                ok = read_fb_u32(&fb, shape + 4 * i, &dim);
+                view.dims[i] = (int32_t)dim;
+            }
+            if (ok && view.num_dims == 0) {
+                // Scalar tensor
+                view.dims[0] = 1;
+                view.num_dims = 1;
+            }
+            ok = ok && find_fb_field(&fb, tensor, TFLITE_TENSOR_TYPE, &pos);
+            if (ok && pos != 0) {
+                ok = pos < fb.size;
+                view.tflite_type = ok ? (int8_t)fb.base[pos] : 0;
+            }
+            view.type_supported = get_tflite_data_type(view.tflite_type, &view.data_type);
+            ok = ok && find_fb_field(&fb, tensor, TFLITE_TENSOR_BUFFER, &pos);
+            if (ok && pos != 0) {
+                ok = read_fb_u32(&fb, pos, &buffer);
+            }
+            view.buffer = buffer;
+            ok = ok && read_tflite_buffer(&fb, buffers, num_buffers, buffer,
+                                          &view.data, &view.data_size);
+            ok = ok && find_fb_vector(&fb, tensor, TFLITE_TENSOR_NAME, 1, &name, &view.name_size);
+            view.name = name ? (const char*)fb.base + name : NULL;
+            if (!ok) {
+                safe_snprintf(error_msg, error_msg_size,
+                        ERROR_MSG_INVALID_TFLITE ": bad tensor %zu of subgraph %zu", t, g);
+                return false;
+            }
+            if (!callback(&view, user_data)) {
+                return true;
+            }
+        }
+    }
+    return true;
+#endif
+}
+
+/**
+ * Callback receiving each converted constant tensor
+ * @param tensor Source tensor view
+ * @param result Conversion result; freed after the callback returns unless the
+ *               callback moves it out (copy the struct, then zero *result)
+ * @param user_data User pointer passed to the driver
+ * @return Returns true to continue, false to stop
+ */
+typedef bool (*tflite_constant_fn)(const tflite_tensor_view_t* tensor,
+                                   conversion_result_t* result, void* user_data);
+
+/**
+ * Bulk conversion driver state
+ */
+typedef struct {
+    tensor_layout_t src_layout;
+    tensor_layout_t dst_layout;
+    tflite_constant_fn callback;
+    void* user_data;
+    size_t converted;
+    bool failed;
+    char* error_msg;
+    size_t error_msg_size;
+} tflite_constants_ctx_t;
+
+static inline bool convert_tflite_constant(const tflite_tensor_view_t* tensor, void* arg) {
+    tflite_constants_ctx_t* ctx = (tflite_constants_ctx_t*)arg;
+    if (!tensor->data || !tensor->type_supported) {
+        return true;
+    }
+
+    conversion_result_t result = {0};
+    size_t element_size = 0, total_elements = 0;
+    bool valid = validate_conversion_shape(tensor->dims, tensor->num_dims, tensor->data_type,
+                                           &element_size, &total_elements,
+                                           result.error_msg, sizeof(result.error_msg));
+    if (valid && tensor->data_size != element_size * total_elements) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_TFLITE ": buffer is %zu bytes, shape needs %zu",
+                tensor->data_size, element_size * total_elements);
+        valid = false;
+    }
+    if (valid) {
+        result = convert_tensor_realigned(tensor->data, tensor->data_size,
+                                          tensor->dims, tensor->num_dims, tensor->data_type,
+                                          ctx->src_layout, ctx->dst_layout);
+    }
+    if (!result.success) {
+        safe_snprintf(ctx->error_msg, ctx->error_msg_size, "Tensor %u of subgraph %u: %s",
+                tensor->index, tensor->subgraph, result.error_msg);
+        ctx->failed = true;
+        return false;
+    }
+
+    ctx->converted++;
+    bool keep_going = ctx->callback(tensor, &result, ctx->user_data);
+    free_conversion_result(&result);
+    return keep_going;
+}
+
+/**
+ * Convert every constant tensor of a TFLite model in one pass
+ * Walks the model (see walk_tflite_model) and converts each tensor that has
+ * buffer data and a supported type, e.g. for an ONNX export. The layout pair
+ * applies to 4-D tensors; others are copied.
+ * @param model Model buffer (.tflite file contents, e.g. a file mapping)
+ * @param size Model buffer size in bytes
+ * @param src_layout Source layout of 4-D constants
+ * @param dst_layout Destination layout of 4-D constants
+ * @param callback Receives each converted tensor
+ * @param user_data User pointer passed to the callback
+ * @param num_converted Output: number of converted tensors, may be NULL
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if successful (or stopped by the callback), false otherwise
+ */
+static inline bool convert_tflite_model_constants(const void* model, size_t size,
+                                                  tensor_layout_t src_layout,
+                                                  tensor_layout_t dst_layout,
+                                                  tflite_constant_fn callback, void* user_data,
+                                                  size_t* num_converted,
+                                                  char* error_msg, size_t error_msg_size) {
+    tflite_constants_ctx_t ctx;
+    if (!callback) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+    ctx.src_layout = src_layout;
+    ctx.dst_layout = dst_layout;
+    ctx.callback = callback;
+    ctx.user_data = user_data;
+    ctx.converted = 0;
+    ctx.failed = false;
+    ctx.error_msg = error_msg;
+    ctx.error_msg_size = error_msg_size;
 
-    // Allocate and copy dimension information
-    result.shape.dims = (int32_t*)malloc(num_dims * sizeof(int32_t));
-    if (!result.shape.dims) {
-        free(result.data);
-        result.data = NULL;
+    bool ok = walk_tflite_model(model, size, convert_tflite_constant, &ctx,
+                                error_msg, error_msg_size);
+    if (num_converted) {
+        *num_converted = ctx.converted;
+    }
+    return ok && !ctx.failed;
+}
+
+/**
+ * Per-tensor or per-channel quantization parameters
+ */
+typedef struct {
+    const float* scales;            // num_channels scales, each > 0
+    const int32_t* zero_points;     // num_channels zero points, NULL for all zero
+    size_t num_channels;            // 1 for per-tensor parameters
+    size_t axis;                    // Channel axis of the source dims (per-channel only)
+} tensor_quant_params_t;
+
+/**
+ * Element-wise span operation applied during a mapped layout conversion
+ * @param op Operation context
+ * @param src Source elements
+ * @param dst Destination elements
+ * @param count Number of contiguous source elements
+ * @param index Linear source index of the first element
+ */
+typedef void (*tensor_span_fn)(const void* op, const void* src, void* dst,
+                               size_t count, size_t index);
+
+/**
+ * Quantization span context
+ */
+typedef struct {
+    quantize_row_fn quantize;
+    const float* scales;
+    const int32_t* zero_points;
+    size_t num_channels;
+    size_t inner;                   // Source elements per channel step
+} quantize_op_t;
+
+/**
+ * Quantize a span of contiguous source elements
+ * The channel of source index i is (i / inner) % num_channels, so a span
+ * splits into runs that either share one channel (broadcast parameters) or,
+ * when the channel axis is innermost, walk the parameter vectors.
+ */
+static inline void quantize_span(const void* arg, const void* src, void* dst,
+                                 size_t count, size_t index) {
+    const quantize_op_t* op = (const quantize_op_t*)arg;
+    const float* src_data = (const float*)src;
+    uint8_t* dst_data = (uint8_t*)dst;
+
+    if (op->num_channels == 1) {
+        op->quantize(src_data, dst_data, count, op->scales, op->zero_points, 0);
+        return;
+    }
+    while (count > 0) {
+        size_t channel = (index / op->inner) % op->num_channels;
+        size_t run = op->inner == 1 ? op->num_channels - channel : op->inner - index % op->inner;
+        if (run > count) {
+            run = count;
+        }
+        op->quantize(src_data, dst_data, run, op->scales + channel,
+                     op->zero_points ? op->zero_points + channel : NULL,
+                     op->inner == 1 ? 1 : 0);
+        src_data += run;
+        dst_data += run;
+        index += run;
+        count -= run;
+    }
+}
+
+/**
+ * Dequantization span context
+ */
+typedef struct {
+    dequantize_row_fn dequantize;
+    const float* scales;
+    const int32_t* zero_points;
+    size_t num_channels;
+    size_t inner;                   // Source elements per channel step
+} dequantize_op_t;
+
+/**
+ * Dequantize a span of contiguous source elements
+ * Channel runs are resolved as in quantize_span.
+ */
+static inline void dequantize_span(const void* arg, const void* src, void* dst,
+                                   size_t count, size_t index) {
+    const dequantize_op_t* op = (const dequantize_op_t*)arg;
+    const uint8_t* src_data = (const uint8_t*)src;
+    float* dst_data = (float*)dst;
+
+    if (op->num_channels == 1) {
+        op->dequantize(src_data, dst_data, count, op->scales, op->zero_points, 0);
+        return;
+    }
+    while (count > 0) {
+        size_t channel = (index / op->inner) % op->num_channels;
+        size_t run = op->inner == 1 ? op->num_channels - channel : op->inner - index % op->inner;
+        if (run > count) {
+            run = count;
+        }
+        op->dequantize(src_data, dst_data, run, op->scales + channel,
+                       op->zero_points ? op->zero_points + channel : NULL,
+                       op->inner == 1 ? 1 : 0);
+        src_data += run;
+        dst_data += run;
+        index += run;
+        count -= run;
+    }
+}
+
+/**
+ * Validate quantization parameters against a tensor shape
+ * @param quant Quantization parameters
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param qmin Lowest valid zero point
+ * @param qmax Highest valid zero point
+ * @param inner Output: source elements per channel step
+ * @param error_msg Error message buffer, filled on failure
+ * @param error_msg_size Error message buffer size
+ * @return Returns true if valid, false otherwise
+ */
+static inline bool validate_quant_params(const tensor_quant_params_t* quant,
+                                         const int32_t* dims, size_t num_dims,
+                                         int32_t qmin, int32_t qmax, size_t* inner,
+                                         char* error_msg, size_t error_msg_size) {
+    if (!quant || !quant->scales || quant->num_channels == 0) {
+        safe_snprintf(error_msg, error_msg_size, ERROR_MSG_INVALID_QUANT);
+        return false;
+    }
+    *inner = 1;
+    if (quant->num_channels > 1) {
+        if (quant->axis >= num_dims || (size_t)dims[quant->axis] != quant->num_channels) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_QUANT ": %zu channels on axis %zu",
+                    quant->num_channels, quant->axis);
+            return false;
+        }
+        for (size_t i = quant->axis + 1; i < num_dims; i++) {
+            *inner *= (size_t)dims[i];
+        }
+    }
+    for (size_t i = 0; i < quant->num_channels; i++) {
+        if (!(quant->scales[i] > 0.0f && quant->scales[i] <= FLT_MAX)) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_QUANT ": scale[%zu]", i);
+            return false;
+        }
+        if (quant->zero_points &&
+            (quant->zero_points[i] < qmin || quant->zero_points[i] > qmax)) {
+            safe_snprintf(error_msg, error_msg_size,
+                    ERROR_MSG_INVALID_QUANT ": zero_point[%zu]", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Mapped transpose task context
+ * Each tile is converted row by row into a scratch tile by the span
+ * operation, then transposed into the destination by the block kernel of the
+ * destination element size.
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t rows;                // Source rows per batch item
+    size_t cols;                // Source columns per batch item
+    size_t strips;              // Row strips per batch item
+    size_t src_element_size;
+    size_t dst_element_size;
+    tensor_span_fn span;
+    const void* op;
+    transpose_block_fn kernel;  // Block kernel for the destination element size
+    size_t tile;                // Tile edge in elements (at most 64)
+} mapped_transpose_ctx_t;
+
+static inline void mapped_transpose_task(void* arg, size_t begin, size_t end) {
+    const mapped_transpose_ctx_t* ctx = (const mapped_transpose_ctx_t*)arg;
+    uint64_t scratch[64 * 64 * 8 / sizeof(uint64_t)];
+    size_t tile = ctx->tile;
+
+    for (size_t item = begin; item < end; item++) {
+        size_t n = item / ctx->strips;
+        size_t r0 = (item % ctx->strips) * tile;
+        size_t block_rows = (ctx->rows - r0 < tile) ? ctx->rows - r0 : tile;
+        size_t base = n * ctx->rows * ctx->cols;
+
+        for (size_t c0 = 0; c0 < ctx->cols; c0 += tile) {
+            size_t block_cols = (ctx->cols - c0 < tile) ? ctx->cols - c0 : tile;
+            for (size_t r = 0; r < block_rows; r++) {
+                size_t index = base + (r0 + r) * ctx->cols + c0;
+                ctx->span(ctx->op, ctx->src + index * ctx->src_element_size,
+                          (char*)scratch + r * tile * ctx->dst_element_size,
+                          block_cols, index);
+            }
+            ctx->kernel(scratch, tile,
+                        ctx->dst + (base + c0 * ctx->rows + r0) * ctx->dst_element_size,
+                        ctx->rows, block_rows, block_cols);
+        }
+    }
+}
+
+/**
+ * Contiguous span task context
+ */
+typedef struct {
+    const char* src;
+    char* dst;
+    size_t count;               // Total number of elements
+    size_t chunk;               // Elements per work item
+    size_t src_element_size;
+    size_t dst_element_size;
+    tensor_span_fn span;
+    const void* op;
+} mapped_span_ctx_t;
+
+static inline void mapped_span_task(void* arg, size_t begin, size_t end) {
+    const mapped_span_ctx_t* ctx = (const mapped_span_ctx_t*)arg;
+    for (size_t item = begin; item < end; item++) {
+        size_t start = item * ctx->chunk;
+        size_t count = (ctx->count - start < ctx->chunk) ? ctx->count - start : ctx->chunk;
+        ctx->span(ctx->op, ctx->src + start * ctx->src_element_size,
+                  ctx->dst + start * ctx->dst_element_size, count, start);
+    }
+}
+
+/**
+ * Layout conversion with an element-wise operation fused in
+ * Source and destination may differ in element size (1/2/4/8 bytes for the
+ * destination). Used by quantization and dequantization.
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param total_elements Total number of elements
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param need_permute Whether the layout permutation is applied
+ * @param src_element_size Source element byte size
+ * @param dst_element_size Destination element byte size
+ * @param span Element-wise operation
+ * @param op Operation context
+ * @param dst_dims Output: destination dimensions
+ */
+static inline void convert_layout_mapped(const void* src, void* dst,
+                                         const int32_t* dims, size_t num_dims,
+                                         size_t total_elements,
+                                         tensor_layout_t src_layout, tensor_layout_t dst_layout,
+                                         bool need_permute,
+                                         size_t src_element_size, size_t dst_element_size,
+                                         tensor_span_fn span, const void* op,
+                                         int32_t* dst_dims) {
+    size_t max_element_size = src_element_size > dst_element_size ? src_element_size
+                                                                   : dst_element_size;
+    size_t max_parts = total_elements * max_element_size / TENSOR_CONVERTER_PARALLEL_GRAIN;
+    size_t batch = 0, rows = 0, cols = 0;
+
+    memcpy(dst_dims, dims, num_dims * sizeof(int32_t));
+    if (need_permute &&
+        get_layout_transpose_shape(dims, src_layout, dst_layout, dst_dims,
+                                   &batch, &rows, &cols)) {
+        mapped_transpose_ctx_t ctx;
+        ctx.src = (const char*)src;
+        ctx.dst = (char*)dst;
+        ctx.rows = rows;
+        ctx.cols = cols;
+        ctx.src_element_size = src_element_size;
+        ctx.dst_element_size = dst_element_size;
+        ctx.span = span;
+        ctx.op = op;
+        ctx.kernel = get_transpose_block_kernel(dst_element_size);
+        ctx.tile = get_transpose_tile(dst_element_size, 0);
+        if (ctx.tile > 64) {
+            ctx.tile = 64;
+        }
+        ctx.strips = (rows + ctx.tile - 1) / ctx.tile;
+        parallel_for(mapped_transpose_task, &ctx, batch * ctx.strips, max_parts);
+        return;
+    }
+
+    mapped_span_ctx_t ctx;
+    ctx.src = (const char*)src;
+    ctx.dst = (char*)dst;
+    ctx.count = total_elements;
+    ctx.chunk = TENSOR_CONVERTER_PARALLEL_GRAIN / max_element_size;
+    ctx.src_element_size = src_element_size;
+    ctx.dst_element_size = dst_element_size;
+    ctx.span = span;
+    ctx.op = op;
+    parallel_for(mapped_span_task, &ctx, (total_elements + ctx.chunk - 1) / ctx.chunk, max_parts);
+}
+
+/**
+ * ONNX to TFLite conversion with fused quantization
+ * Float32 input is quantized to int8 or uint8 as
+ * clamp(round_half_even(x / scale) + zero_point) while it is permuted into
+ * the destination layout, in a single pass. Per-channel parameters refer to
+ * quant->axis of the source dims.
+ * @param onnx_data ONNX float32 tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param dst_type TENSOR_INT8 or TENSOR_UINT8
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param quant Quantization parameters
+ * @return conversion_result_t Conversion result
+ */
+static inline conversion_result_t onnx_to_tflite_with_layout_quantize(
+    const void* onnx_data, const int32_t* dims, size_t num_dims,
+    tensor_data_type_t dst_type, tensor_layout_t src_layout, tensor_layout_t dst_layout,
+    const tensor_quant_params_t* quant) {
+    conversion_result_t result = {0};
+    size_t src_element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(onnx_data, dims, num_dims, TENSOR_FLOAT32,
+                                  &src_element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (dst_type != TENSOR_INT8 && dst_type != TENSOR_UINT8) {
         safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                ERROR_MSG_MEMORY_ALLOC);
+                ERROR_MSG_UNSUPPORTED_TYPE ": quantize to %d", dst_type);
         return result;
     }
 
-    // Set result information
+    quantize_op_t op;
+    bool is_signed = dst_type == TENSOR_INT8;
+    if (!validate_quant_params(quant, dims, num_dims, is_signed ? -128 : 0, is_signed ? 127 : 255,
+                               &op.inner, result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    bool need_permute = false;
+    if (!check_fused_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                       result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    void* copy = NULL;
+    const void* src = get_aligned_source(onnx_data, src_element_size * total_elements,
+                                         src_element_size, &copy,
+                                         result.error_msg, sizeof(result.error_msg));
+    if (!src) {
+        return result;
+    }
+    if (!allocate_conversion_result(&result, total_elements, num_dims)) {
+        free(copy);
+        return result;
+    }
+
+    op.quantize = get_kernel_table()->quantize_row[is_signed ? 0 : 1];
+    op.scales = quant->scales;
+    op.zero_points = quant->zero_points;
+    op.num_channels = quant->num_channels;
+    convert_layout_mapped(src, result.data, dims, num_dims, total_elements,
+                          src_layout, dst_layout, need_permute, src_element_size, 1,
+                          quantize_span, &op, result.shape.dims);
+    free(copy);
+
     result.shape.num_dims = num_dims;
-    result.shape.data_type = data_type;
+    result.shape.data_type = dst_type;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = dst_layout;
+    result.data_size = total_elements;
+    result.success = true;
+    return result;
+}
+
+/**
+ * TFLite to ONNX conversion with fused dequantization
+ * Int8 or uint8 input is dequantized to float32 as
+ * (q - zero_point) * scale while it is permuted into the destination
+ * layout, in a single pass. Per-channel parameters refer to quant->axis of
+ * the source dims (the last axis for NHWC channels).
+ * @param tflite_data TFLite int8/uint8 tensor data pointer
+ * @param dims Tensor dimension array
+ * @param num_dims Number of dimensions
+ * @param src_type TENSOR_INT8 or TENSOR_UINT8
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @param quant Quantization parameters
+ * @return conversion_result_t Conversion result (TENSOR_FLOAT32)
+ */
+static inline conversion_result_t tflite_to_onnx_with_layout_dequantize(
+    const void* tflite_data, const int32_t* dims, size_t num_dims,
+    tensor_data_type_t src_type, tensor_layout_t src_layout, tensor_layout_t dst_layout,
+    const tensor_quant_params_t* quant) {
+    conversion_result_t result = {0};
+    size_t src_element_size = 0;
+    size_t total_elements = 0;
+
+    if (src_type != TENSOR_INT8 && src_type != TENSOR_UINT8) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_UNSUPPORTED_TYPE ": dequantize from %d", src_type);
+        return result;
+    }
+    if (!validate_conversion_args(tflite_data, dims, num_dims, src_type,
+                                  &src_element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    if (total_elements > SIZE_MAX / sizeof(float)) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": size too large");
+        return result;
+    }
+
+    dequantize_op_t op;
+    bool is_signed = src_type == TENSOR_INT8;
+    if (!validate_quant_params(quant, dims, num_dims, is_signed ? -128 : 0, is_signed ? 127 : 255,
+                               &op.inner, result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    bool need_permute = false;
+    if (!check_fused_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                       result.error_msg, sizeof(result.error_msg))) {
+        return result;
+    }
+    size_t total_bytes = total_elements * sizeof(float);
+    if (!allocate_conversion_result(&result, total_bytes, num_dims)) {
+        return result;
+    }
+
+    op.dequantize = get_kernel_table()->dequantize_row[is_signed ? 0 : 1];
+    op.scales = quant->scales;
+    op.zero_points = quant->zero_points;
+    op.num_channels = quant->num_channels;
+    convert_layout_mapped(tflite_data, result.data, dims, num_dims, total_elements,
+                          src_layout, dst_layout, need_permute, src_element_size, sizeof(float),
+                          dequantize_span, &op, result.shape.dims);
+
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = TENSOR_FLOAT32;
     result.shape.total_elements = total_elements;
     result.shape.layout = dst_layout;
     result.data_size = total_bytes;
+    result.success = true;
+    return result;
+}
 
-    // Check if layout conversion is needed
-    bool need_layout_conversion = false;
-    if (num_dims == 4 && src_layout != dst_layout) {
-        // Only conversion between NCHW and NHWC is supported
-        if ((src_layout == LAYOUT_NCHW && dst_layout == LAYOUT_NHWC) ||
-            (src_layout == LAYOUT_NHWC && dst_layout == LAYOUT_NCHW)) {
-            need_layout_conversion = true;
-        } else if (src_layout != LAYOUT_UNKNOWN && dst_layout != LAYOUT_UNKNOWN) {
-            // Any other explicit layout conversion is not supported
-            free(result.data);
-            free(result.shape.dims);
-            result.data = NULL;
-            result.shape.dims = NULL;
-            safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                    ERROR_MSG_LAYOUT_CONVERSION ": from %d to %d", src_layout, dst_layout);
-            return result;
-        }
+/**
+ * Image normalization parameters
+ * Indexed by destination (model) channel.
+ */
+typedef struct {
+    const float* mean;      // Per-channel mean, NULL for 0
+    const float* inv_std;   // Per-channel 1 / std, NULL for 1
+    bool swap_rb;           // Exchange channels 0 and 2 (BGR <-> RGB), needs C >= 3
+} tensor_normalize_params_t;
+
+/**
+ * Image normalization task context
+ */
+typedef struct {
+    const uint8_t* src;
+    float* dst;
+    size_t pixels;              // H * W
+    size_t channels;
+    size_t chunk;               // Pixels per work item
+    size_t chunks_per_batch;    // Work items per image
+    const tensor_normalize_params_t* params;
+    normalize_pixels_fn normalize;
+} normalize_image_ctx_t;
+
+static inline void normalize_image_task(void* arg, size_t begin, size_t end) {
+    const normalize_image_ctx_t* ctx = (const normalize_image_ctx_t*)arg;
+    size_t image_elements = ctx->pixels * ctx->channels;
+    for (size_t item = begin; item < end; item++) {
+        size_t n = item / ctx->chunks_per_batch;
+        size_t start = (item % ctx->chunks_per_batch) * ctx->chunk;
+        size_t count = (ctx->pixels - start < ctx->chunk) ? ctx->pixels - start : ctx->chunk;
+        ctx->normalize(ctx->src + n * image_elements + start * ctx->channels,
+                       ctx->dst + n * image_elements + start, count,
+                       ctx->channels, ctx->pixels,
+                       ctx->params->mean, ctx->params->inv_std, ctx->params->swap_rb);
     }
+}
 
-    if (need_layout_conversion) {
-        // Layout conversion needed
-        if (src_layout == LAYOUT_NHWC && dst_layout == LAYOUT_NCHW) {
-            // NHWC -> NCHW
-            memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-            // Convert dimension order: [N,H,W,C] -> [N,C,H,W]
-            // Keep N at index 0, move C to index 1, H to index 2, W to index 3
-            result.shape.dims[1] = dims[3]; // C (was at index 3)
-            result.shape.dims[2] = dims[1]; // H (was at index 1)
-            result.shape.dims[3] = dims[2]; // W (was at index 2)
-
-            if (!convert_nhwc_to_nchw(tflite_data, result.data,
-                                     dims[0], dims[1], dims[2], dims[3],
-                                     element_size)) {
-                free(result.data);
-                free(result.shape.dims);
-                result.data = NULL;
-                result.shape.dims = NULL;
-                safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                        ERROR_MSG_LAYOUT_CONVERSION);
-                return result;
-            }
-        } else if (src_layout == LAYOUT_NCHW && dst_layout == LAYOUT_NHWC) {
-            // NCHW -> NHWC
-            memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-            // Convert dimension order: [N,C,H,W] -> [N,H,W,C]
-            // Keep N at index 0, move H to index 1, W to index 2, C to index 3
-            result.shape.dims[1] = dims[2]; // H (was at index 2)
-            result.shape.dims[2] = dims[3]; // W (was at index 3)
-            result.shape.dims[3] = dims[1]; // C (was at index 1)
-
-            if (!convert_nchw_to_nhwc(tflite_data, result.data,
-                                     dims[0], dims[1], dims[2], dims[3],
-                                     element_size)) {
-                free(result.data);
-                free(result.shape.dims);
-                result.data = NULL;
-                result.shape.dims = NULL;
-                safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                        ERROR_MSG_LAYOUT_CONVERSION);
-                return result;
-            }
-        }
-    } else {
-        // No layout conversion needed, copy directly
-        memcpy(result.shape.dims, dims, num_dims * sizeof(int32_t));
-        if (!copy_tensor_data(tflite_data, result.data, element_size, total_elements)) {
-            free(result.data);
-            free(result.shape.dims);
-            result.data = NULL;
-            result.shape.dims = NULL;
-            safe_snprintf(result.error_msg, sizeof(result.error_msg),
-                    ERROR_MSG_DATA_COPY);
-            return result;
-        }
+/**
+ * Convert a uint8 NHWC image batch into a normalized float32 NCHW tensor
+ * Widening, (x - mean[c]) * inv_std[c] and the NHWC -> NCHW scatter happen
+ * in one pass over the input. For [0, 1] scaled models fold the 1/255 into
+ * the parameters (mean * 255, inv_std / 255).
+ * @param tflite_data Uint8 NHWC image data pointer
+ * @param dims Tensor dimension array [N, H, W, C]
+ * @param num_dims Number of dimensions (must be 4)
+ * @param params Normalization parameters, NULL to only widen to float32
+ * @return conversion_result_t Conversion result (TENSOR_FLOAT32, LAYOUT_NCHW)
+ */
+static inline conversion_result_t tflite_to_onnx_normalize_image(
+    const void* tflite_data, const int32_t* dims, size_t num_dims,
+    const tensor_normalize_params_t* params) {
+    conversion_result_t result = {0};
+    tensor_normalize_params_t default_params = {NULL, NULL, false};
+    size_t element_size = 0;
+    size_t total_elements = 0;
+
+    if (!validate_conversion_args(tflite_data, dims, num_dims, TENSOR_UINT8,
+                                  &element_size, &total_elements,
+                                  result.error_msg, sizeof(result.error_msg))) {
+        return result;
     }
+    if (num_dims != 4) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": image must be NHWC, got %zu dims", num_dims);
+        return result;
+    }
+    if (!params) {
+        params = &default_params;
+    }
+    if (params->swap_rb && dims[3] < 3) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": swap_rb needs at least 3 channels, got %d", dims[3]);
+        return result;
+    }
+    if (total_elements > SIZE_MAX / sizeof(float)) {
+        safe_snprintf(result.error_msg, sizeof(result.error_msg),
+                ERROR_MSG_INVALID_DIMS ": size too large");
+        return result;
+    }
+    size_t total_bytes = total_elements * sizeof(float);
+    if (!allocate_conversion_result(&result, total_bytes, num_dims)) {
+        return result;
+    }
+
+    normalize_image_ctx_t ctx;
+    size_t batch = (size_t)dims[0];
+    ctx.src = (const uint8_t*)tflite_data;
+    ctx.dst = (float*)result.data;
+    ctx.pixels = (size_t)dims[1] * (size_t)dims[2];
+    ctx.channels = (size_t)dims[3];
+    ctx.params = params;
+    ctx.normalize = get_kernel_table()->normalize_pixels;
+    // Work items of about one grain of output, rounded to the 16-pixel SIMD step
+    ctx.chunk = (TENSOR_CONVERTER_PARALLEL_GRAIN / (ctx.channels * sizeof(float)) + 15) / 16 * 16;
+    if (ctx.chunk > ctx.pixels) {
+        ctx.chunk = ctx.pixels;
+    }
+    ctx.chunks_per_batch = (ctx.pixels + ctx.chunk - 1) / ctx.chunk;
+    parallel_for(normalize_image_task, &ctx, batch * ctx.chunks_per_batch,
+                 total_bytes / TENSOR_CONVERTER_PARALLEL_GRAIN);
 
+    result.shape.dims[0] = dims[0];
+    result.shape.dims[1] = dims[3];
+    result.shape.dims[2] = dims[1];
+    result.shape.dims[3] = dims[2];
+    result.shape.num_dims = num_dims;
+    result.shape.data_type = TENSOR_FLOAT32;
+    result.shape.total_elements = total_elements;
+    result.shape.layout = LAYOUT_NCHW;
+    result.data_size = total_bytes;
     result.success = true;
     return result;
 }
 
+/**
+ * Conversion plan operation
+ */
+typedef enum {
+    PLAN_OP_COPY = 0,       // Layouts match, plain copy
+    PLAN_OP_TRANSPOSE = 1,  // Batch of 2D transposes
+    PLAN_OP_PERMUTE = 2     // General 4D permutation (OIHW <-> HWIO)
+} conversion_plan_op_t;
+
+/**
+ * Reusable conversion plan
+ * Created once for a fixed shape, data type and layout pair; holds the
+ * destination dims, the derived transpose shape, the selected kernel and
+ * tile size so that execution does no validation and no allocation.
+ */
+typedef struct {
+    int32_t src_dims[TENSOR_MAX_DIMS];  // Source dimensions
+    int32_t dst_dims[TENSOR_MAX_DIMS];  // Destination dimensions
+    size_t num_dims;                    // Number of dimensions
+    tensor_data_type_t data_type;       // Data type
+    tensor_layout_t src_layout;         // Source layout format
+    tensor_layout_t dst_layout;         // Destination layout format
+    size_t element_size;                // Single element byte size
+    size_t total_elements;              // Total number of elements
+    size_t data_size;                   // Data size (bytes) of source and destination
+    conversion_plan_op_t op;            // Operation
+    size_t batch;                       // Transpose: number of matrices
+    size_t rows;                        // Transpose: source rows per matrix
+    size_t cols;                        // Transpose: source columns per matrix
+    transpose_block_fn kernel;          // Transpose: block kernel (NULL for generic)
+    size_t tile;                        // Transpose: tile edge in elements
+    size_t perm[4];                     // Permute: destination axis i is source axis perm[i]
+    bool valid;                         // Whether the plan was created successfully
+    char error_msg[ERROR_MSG_SIZE];     // Error message
+} conversion_plan_t;
+
+/**
+ * Create a reusable conversion plan
+ * @param plan Plan to fill
+ * @param dims Source dimension array
+ * @param num_dims Number of dimensions
+ * @param data_type Data type
+ * @param src_layout Source layout format
+ * @param dst_layout Destination layout format
+ * @return Returns true if successful; otherwise plan->error_msg is filled
+ */
+static inline bool create_conversion_plan(conversion_plan_t* plan,
+                                          const int32_t* dims,
+                                          size_t num_dims,
+                                          tensor_data_type_t data_type,
+                                          tensor_layout_t src_layout,
+                                          tensor_layout_t dst_layout) {
+    if (!plan) {
+        return false;
+    }
+    memset(plan, 0, sizeof(*plan));
+
+    if (!dims || num_dims == 0) {
+        safe_snprintf(plan->error_msg, sizeof(plan->error_msg), ERROR_MSG_NULL_POINTER);
+        return false;
+    }
+    if (!validate_conversion_shape(dims, num_dims, data_type,
+                                   &plan->element_size, &plan->total_elements,
+                                   plan->error_msg, sizeof(plan->error_msg))) {
+        return false;
+    }
+    bool need_permute = false;
+    if (!check_layout_conversion(num_dims, src_layout, dst_layout, &need_permute,
+                                 plan->error_msg, sizeof(plan->error_msg))) {
+        return false;
+    }
+
+    memcpy(plan->src_dims, dims, num_dims * sizeof(int32_t));
+    memcpy(plan->dst_dims, dims, num_dims * sizeof(int32_t));
+    plan->num_dims = num_dims;
+    plan->data_type = data_type;
+    plan->src_layout = src_layout;
+    plan->dst_layout = dst_layout;
+    plan->data_size = plan->element_size * plan->total_elements;
+    plan->op = PLAN_OP_COPY;
+
+    if (need_permute && !is_batched_layout_permutation(src_layout, dst_layout)) {
+        plan->op = PLAN_OP_PERMUTE;
+        get_layout_permutation(src_layout, dst_layout, plan->perm);
+        for (size_t i = 0; i < 4; i++) {
+            plan->dst_dims[i] = dims[plan->perm[i]];
+        }
+    } else if (need_permute) {
+        plan->op = PLAN_OP_TRANSPOSE;
+        if (!get_layout_transpose_shape(dims, src_layout, dst_layout, plan->dst_dims,
+                                        &plan->batch, &plan->rows, &plan->cols)) {
+            plan->op = PLAN_OP_COPY;
+        }
+        plan->kernel = get_transpose_block_kernel(plan->element_size);
+        plan->tile = get_transpose_tile(plan->element_size, 0);
+    }
+
+    plan->valid = true;
+    return true;
+}
+
+/**
+ * Execute a conversion plan
+ * Performs no validation and no allocation: the plan must have been created
+ * successfully, src must hold plan->data_size bytes in the source layout and
+ * dst must have room for plan->data_size bytes. Destination dims are in
+ * plan->dst_dims.
+ * @param plan Conversion plan
+ * @param src Source data pointer
+ * @param dst Destination data pointer
+ */
+static inline void execute_conversion_plan(const conversion_plan_t* plan,
+                                           const void* src, void* dst) {
+    if (plan->op == PLAN_OP_TRANSPOSE) {
+        transpose_batched_with(src, dst, plan->batch, plan->rows, plan->cols,
+                               plan->element_size, plan->kernel, plan->tile);
+    } else if (plan->op == PLAN_OP_PERMUTE) {
+        size_t extents[4];
+        for (size_t i = 0; i < 4; i++) {
+            extents[i] = (size_t)plan->src_dims[i];
+        }
+        transpose_tensor_unchecked(src, dst, extents, 4, plan->perm, plan->element_size);
+    } else {
+        memcpy(dst, src, plan->data_size);
+    }
+}
+
 // ============================================================================
 // Function implementations
 // ============================================================================
@@ -765,7 +6766,7 @@ static inline size_t calculate_total_elements(const int32_t* dims, size_t num_di
 }
 
 static inline bool validate_tensor_shape(const int32_t* dims, size_t num_dims) {
-    if (!dims || num_dims == 0 || num_dims > 8) { // Limit to maximum 8 dimensions
+    if (!dims || num_dims == 0 || num_dims > TENSOR_MAX_DIMS) {
         return false;
     }
 
@@ -827,6 +6828,12 @@ static inline void free_conversion_result(conversion_result_t* result) {
     if (!result) {
         return;
     }
+    if (result->borrowed) {
+        // Caller memory: only drop the references
+        result->data = NULL;
+        result->shape.dims = NULL;
+        result->borrowed = false;
+    }
     if (result->data) {
         free(result->data);
         result->data = NULL;